@@ -62,6 +62,9 @@
  #include <net/if_dl.h>
  #include <mach/mach_time.h>
  #include <mach-o/dyld.h>
+ #include <spawn.h>
+ #include <poll.h>
+ #include <crt_externs.h>
 
 //==============================================================================
 #elif JUCE_WINDOWS
@@ -183,6 +186,8 @@
  #include <sys/prctl.h>
  #include <signal.h>
  #include <stddef.h>
+ #include <spawn.h>
+ #include <poll.h>
 
 //==============================================================================
 #elif JUCE_ANDROID
@@ -203,6 +208,7 @@
  #include <dirent.h>
  #include <fnmatch.h>
  #include <sys/wait.h>
+ #include <poll.h>
 #endif
 
 // Need to clear various moronic redefinitions made by system headers..
@@ -262,7 +262,18 @@ public:
                 {
                     filenameFound = CharPointer_UTF8 (de->d_name);
 
-                    updateStatInfoForFile (parentDir + filenameFound, isDir, fileSize, modTime, creationTime, isReadOnly);
+                    // if only the directory flag is needed, the dirent can usually provide it
+                    // without the cost of a stat() call..
+                    if (fileSize == nullptr && modTime == nullptr && creationTime == nullptr && isReadOnly == nullptr
+                         && de->d_type != DT_UNKNOWN && de->d_type != DT_LNK)
+                    {
+                        if (isDir != nullptr)
+                            *isDir = (de->d_type == DT_DIR);
+                    }
+                    else
+                    {
+                        updateStatInfoForFile (parentDir + filenameFound, isDir, fileSize, modTime, creationTime, isReadOnly);
+                    }
 
                     if (isHidden != nullptr)
                         *isHidden = filenameFound.startsWithChar ('.');
@@ -672,14 +672,18 @@ void juce_runSystemCommand (const String& command)
 String juce_getOutputFromCommand (const String&);
 String juce_getOutputFromCommand (const String& command)
 {
-    // slight bodge here, as we just pipe the output into a temp file and read it...
-    const File tempFile (File::getSpecialLocation (File::tempDirectory)
-                           .getNonexistentChildFile (String::toHexString (Random::getSystemRandom().nextInt()), ".tmp", false));
+    StringArray arguments;
+    arguments.add ("/bin/sh");
+    arguments.add ("-c");
+    arguments.add (command);
 
-    juce_runSystemCommand (command + " > " + tempFile.getFullPathName());
+    ChildProcess process;
 
-    String result (tempFile.loadFileAsString());
-    tempFile.deleteFile();
+    if (! process.start (arguments))
+        return String::empty;
+
+    const String result (process.readAllProcessOutput());
+    process.waitForProcessToFinish (-1);
     return result;
 }
 
@@ -965,78 +969,146 @@ void* DynamicLibrary::getFunction (const String& functionName) noexcept
 class ChildProcess::ActiveProcess
 {
 public:
-    ActiveProcess (const StringArray& arguments)
-        : childPID (0), pipeHandle (0), readHandle (0)
+    ActiveProcess (const StringArray& arguments, const int streamFlags)
+        : childPID (0), outputHandle (-1), errorHandle (-1), exitCode (0), hasFinished (false)
     {
-        int pipeHandles[2] = { 0 };
+        int outputPipe[2] = { -1, -1 };
+        int errorPipe[2]  = { -1, -1 };
 
-        if (pipe (pipeHandles) == 0)
+        if (createPipe (outputPipe, (streamFlags & wantStdOut) != 0)
+             && createPipe (errorPipe, (streamFlags & wantStdErr) != 0))
         {
+            Array<char*> argv;
+            for (int i = 0; i < arguments.size(); ++i)
+                argv.add (arguments[i].toUTF8().getAddress());
+
+            argv.add (nullptr);
+
+           #if JUCE_ANDROID
             const pid_t result = fork();
 
-            if (result < 0)
-            {
-                close (pipeHandles[0]);
-                close (pipeHandles[1]);
-            }
-            else if (result == 0)
+            if (result == 0)
             {
                 // we're the child process..
-                close (pipeHandles[0]);   // close the read handle
-                dup2 (pipeHandles[1], 1); // turns the pipe into stdout
-                close (pipeHandles[1]);
-
-                Array<char*> argv;
-                for (int i = 0; i < arguments.size(); ++i)
-                    argv.add (arguments[i].toUTF8().getAddress());
-
-                argv.add (nullptr);
+                if (outputPipe[1] >= 0)  dup2 (outputPipe[1], 1);
+                if (errorPipe[1] >= 0)   dup2 (errorPipe[1], 2);
 
                 execvp (argv[0], argv.getRawDataPointer());
                 exit (-1);
             }
-            else
-            {
-                // we're the parent process..
+
+            if (result > 0)
                 childPID = result;
-                pipeHandle = pipeHandles[0];
-                close (pipeHandles[1]); // close the write handle
-            }
+           #else
+            // posix_spawn avoids the cost of fork() copying the page tables of a big process.
+            // The pipes are all close-on-exec, so the only handles that the child inherits are
+            // the ones that get duplicated onto its stdout and stderr.
+            posix_spawn_file_actions_t actions;
+            posix_spawn_file_actions_init (&actions);
+
+            if (outputPipe[1] >= 0)  posix_spawn_file_actions_adddup2 (&actions, outputPipe[1], 1);
+            if (errorPipe[1] >= 0)   posix_spawn_file_actions_adddup2 (&actions, errorPipe[1], 2);
+
+            pid_t result = 0;
+
+            if (posix_spawnp (&result, argv[0], &actions, nullptr, argv.getRawDataPointer(), getEnvironment()) == 0)
+                childPID = result;
+
+            posix_spawn_file_actions_destroy (&actions);
+           #endif
+        }
+
+        closeHandle (outputPipe[1]);
+        closeHandle (errorPipe[1]);
+
+        if (childPID != 0)
+        {
+            outputHandle = outputPipe[0];
+            errorHandle = errorPipe[0];
+        }
+        else
+        {
+            closeHandle (outputPipe[0]);
+            closeHandle (errorPipe[0]);
         }
     }
 
     ~ActiveProcess()
     {
-        if (readHandle != 0)
-            fclose (readHandle);
+        closeHandle (outputHandle);
+        closeHandle (errorHandle);
 
-        if (pipeHandle != 0)
-            close (pipeHandle);
+        // (this reaps the child if it's already finished, but won't wait for it)
+        isRunning();
     }
 
     bool isRunning() const
     {
-        if (childPID != 0)
+        if (childPID != 0 && ! hasFinished)
         {
-            int childState;
-            const int pid = waitpid (childPID, &childState, WNOHANG);
-            return pid > 0 && ! (WIFEXITED (childState) || WIFSIGNALED (childState));
+            int childState = 0;
+            const pid_t pid = waitpid (childPID, &childState, WNOHANG);
+
+            if (pid == 0)
+                return true;
+
+            hasFinished = true;
+
+            if (pid > 0)
+                exitCode = WIFEXITED (childState) ? (uint32) WEXITSTATUS (childState)
+                                                  : (uint32) (128 + WTERMSIG (childState));
         }
 
         return false;
     }
 
-    int read (void* const dest, const int numBytes)
+    int read (void* const dest, const int numBytes, const bool fromErrorStream)
     {
         jassert (dest != nullptr);
+        int total = takeBufferedData (dest, numBytes, fromErrorStream);
 
-        if (readHandle == 0 && childPID != 0)
-            readHandle = fdopen (pipeHandle, "r");
+        while (total < numBytes)
+        {
+            const int handle = fromErrorStream ? errorHandle : outputHandle;
+
+            if (handle < 0 || ! waitUntilReadable (fromErrorStream))
+                break;
 
-        if (readHandle != 0)
-            return fread (dest, 1, numBytes, readHandle);
+            const ssize_t numRead = ::read (handle, addBytesToPointer (dest, total), (size_t) (numBytes - total));
 
-        return 0;
+            if (numRead > 0)
+                total += (int) numRead;
+            else if (numRead == 0 || errno != EINTR)
+                break;
+        }
+
+        return total;
+    }
+
+    int readAvailable (void* const dest, const int maxBytes, const bool fromErrorStream)
+    {
+        jassert (dest != nullptr);
+        const int numBuffered = takeBufferedData (dest, maxBytes, fromErrorStream);
+
+        if (numBuffered > 0)
+            return numBuffered;
+
+        const int handle = fromErrorStream ? errorHandle : outputHandle;
+
+        if (handle < 0)
+            return -1;
+
+        pollfd pfd = { handle, POLLIN, 0 };
+
+        if (poll (&pfd, 1, 0) <= 0)
+            return 0;
+
+        const ssize_t numRead = ::read (handle, dest, (size_t) maxBytes);
+
+        if (numRead > 0)
+            return (int) numRead;
+
+        return (numRead < 0 && errno == EINTR) ? 0 : -1;
     }
 
     bool killProcess() const
@@ -1044,25 +1116,134 @@ public:
         return ::kill (childPID, SIGKILL) == 0;
     }
 
+    uint32 getExitCode() const
+    {
+        isRunning();
+        return exitCode;
+    }
+
     int childPID;
 
 private:
-    int pipeHandle;
-    FILE* readHandle;
+    int outputHandle, errorHandle;
+    MemoryBlock bufferedOutput, bufferedError;
+    mutable uint32 exitCode;
+    mutable bool hasFinished;
+
+    int takeBufferedData (void* const dest, const int maxBytes, const bool fromErrorStream)
+    {
+        MemoryBlock& buffer = fromErrorStream ? bufferedError : bufferedOutput;
+        const int num = jmin (maxBytes, (int) buffer.getSize());
+
+        if (num > 0)
+        {
+            memcpy (dest, buffer.getData(), (size_t) num);
+            buffer.removeSection (0, (size_t) num);
+        }
+
+        return num;
+    }
+
+    /*  Blocks until the stream that's being read has some data or has been closed. If both
+        streams are being captured, anything that arrives on the other one in the meantime
+        is read into its buffer, because a child that fills up one pipe while we're waiting
+        on the other would otherwise never finish.
+    */
+    bool waitUntilReadable (const bool fromErrorStream)
+    {
+        for (;;)
+        {
+            const int handle      = fromErrorStream ? errorHandle  : outputHandle;
+            int& otherHandle      = fromErrorStream ? outputHandle : errorHandle;
+            MemoryBlock& otherBuffer = fromErrorStream ? bufferedOutput : bufferedError;
+
+            if (otherHandle < 0)
+                return true;
+
+            pollfd pfds[2] = { { handle, POLLIN, 0 }, { otherHandle, POLLIN, 0 } };
+
+            if (poll (pfds, 2, -1) < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+
+                return false;
+            }
+
+            if (pfds[0].revents != 0)
+                return true;
+
+            if (pfds[1].revents != 0)
+            {
+                char data [4096];
+                const ssize_t numRead = ::read (otherHandle, data, sizeof (data));
+
+                if (numRead > 0)
+                {
+                    otherBuffer.append (data, (size_t) numRead);
+                }
+                else if (numRead == 0 || errno != EINTR)
+                {
+                    // (the other stream has finished, so stop watching it)
+                    closeHandle (otherHandle);
+                    otherHandle = -1;
+                }
+            }
+        }
+    }
+
+    static bool createPipe (int* handles, const bool isNeeded)
+    {
+        if (! isNeeded)
+            return true;
+
+       #if JUCE_LINUX
+        return pipe2 (handles, O_CLOEXEC) == 0;
+       #else
+        if (pipe (handles) != 0)
+            return false;
+
+        fcntl (handles[0], F_SETFD, FD_CLOEXEC);
+        fcntl (handles[1], F_SETFD, FD_CLOEXEC);
+        return true;
+       #endif
+    }
+
+    static void closeHandle (const int handle)
+    {
+        if (handle >= 0)
+            close (handle);
+    }
+
+   #if ! JUCE_ANDROID
+    static char** getEnvironment()
+    {
+       #if JUCE_MAC || JUCE_IOS
+        return *_NSGetEnviron();
+       #else
+        return environ;
+       #endif
+    }
+   #endif
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ActiveProcess);
 };
 
-bool ChildProcess::start (const String& command)
+bool ChildProcess::start (const String& command, const int streamFlags)
 {
     StringArray tokens;
     tokens.addTokens (command, true);
     tokens.removeEmptyStrings (true);
 
-    if (tokens.size() == 0)
+    return start (tokens, streamFlags);
+}
+
+bool ChildProcess::start (const StringArray& arguments, const int streamFlags)
+{
+    if (arguments.size() == 0)
         return false;
 
-    activeProcess = new ActiveProcess (tokens);
+    activeProcess = new ActiveProcess (arguments, streamFlags);
 
     if (activeProcess->childPID == 0)
         activeProcess = nullptr;
@@ -1077,7 +1258,22 @@ bool ChildProcess::isRunning() const
 
 int ChildProcess::readProcessOutput (void* dest, int numBytes)
 {
-    return activeProcess != nullptr ? activeProcess->read (dest, numBytes) : 0;
+    return activeProcess != nullptr ? activeProcess->read (dest, numBytes, false) : 0;
+}
+
+int ChildProcess::readProcessErrorOutput (void* dest, int numBytes)
+{
+    return activeProcess != nullptr ? activeProcess->read (dest, numBytes, true) : 0;
+}
+
+int ChildProcess::readAvailableProcessOutput (void* dest, int maxBytes, bool readErrorOutput)
+{
+    return activeProcess != nullptr ? activeProcess->readAvailable (dest, maxBytes, readErrorOutput) : -1;
+}
+
+uint32 ChildProcess::getExitCode() const
+{
+    return activeProcess != nullptr ? activeProcess->getExitCode() : 0;
 }
 
 bool ChildProcess::kill()
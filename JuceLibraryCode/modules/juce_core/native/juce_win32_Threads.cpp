@@ -464,7 +464,7 @@ void InterProcessLock::exit()
 class ChildProcess::ActiveProcess
 {
 public:
-    ActiveProcess (const String& command)
+    ActiveProcess (const String& command, const int streamFlags)
         : ok (false), readPipe (0), writePipe (0)
     {
         SECURITY_ATTRIBUTES securityAtts = { 0 };
@@ -484,6 +484,8 @@ public:
                                 nullptr, nullptr, TRUE, CREATE_NO_WINDOW | CREATE_UNICODE_ENVIRONMENT,
                                 nullptr, nullptr, &startupInfo, &processInfo) != FALSE;
         }
+
+        (void) streamFlags; // (the pipe always gets both streams on Windows)
     }
 
     ~ActiveProcess()
@@ -541,11 +543,35 @@ public:
         return total;
     }
 
+    int readAvailable (void* dest, const int maxBytes) const
+    {
+        DWORD available = 0;
+
+        if (! (ok && PeekNamedPipe ((HANDLE) readPipe, nullptr, 0, nullptr, &available, nullptr)))
+            return -1;
+
+        if (available == 0)
+            return isRunning() ? 0 : -1;
+
+        DWORD numRead = 0;
+        if (! ReadFile ((HANDLE) readPipe, dest, jmin ((DWORD) maxBytes, available), &numRead, nullptr))
+            return -1;
+
+        return (int) numRead;
+    }
+
     bool killProcess() const
     {
         return TerminateProcess (processInfo.hProcess, 0) != FALSE;
     }
 
+    uint32 getExitCode() const
+    {
+        DWORD exitCode = 0;
+        GetExitCodeProcess (processInfo.hProcess, &exitCode);
+        return (uint32) exitCode;
+    }
+
     bool ok;
 
 private:
@@ -555,9 +581,9 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ActiveProcess);
 };
 
-bool ChildProcess::start (const String& command)
+bool ChildProcess::start (const String& command, const int streamFlags)
 {
-    activeProcess = new ActiveProcess (command);
+    activeProcess = new ActiveProcess (command, streamFlags);
 
     if (! activeProcess->ok)
         activeProcess = nullptr;
@@ -565,6 +591,23 @@ bool ChildProcess::start (const String& command)
     return activeProcess != nullptr;
 }
 
+bool ChildProcess::start (const StringArray& arguments, const int streamFlags)
+{
+    String command;
+
+    for (int i = 0; i < arguments.size(); ++i)
+    {
+        String arg (arguments[i]);
+
+        if (arg.containsChar (' '))
+            arg = arg.quoted();
+
+        command << arg << ' ';
+    }
+
+    return start (command.trim(), streamFlags);
+}
+
 bool ChildProcess::isRunning() const
 {
     return activeProcess != nullptr && activeProcess->isRunning();
@@ -575,6 +618,24 @@ int ChildProcess::readProcessOutput (void* dest, int numBytes)
     return activeProcess != nullptr ? activeProcess->read (dest, numBytes) : 0;
 }
 
+int ChildProcess::readProcessErrorOutput (void*, int)
+{
+    return 0;
+}
+
+int ChildProcess::readAvailableProcessOutput (void* dest, int maxBytes, bool readErrorOutput)
+{
+    if (activeProcess == nullptr || readErrorOutput)
+        return -1;
+
+    return activeProcess->readAvailable (dest, maxBytes);
+}
+
+uint32 ChildProcess::getExitCode() const
+{
+    return activeProcess != nullptr ? activeProcess->getExitCode() : 0;
+}
+
 bool ChildProcess::kill()
 {
     return activeProcess == nullptr || activeProcess->killProcess();
@@ -34,6 +34,8 @@ bool ChildProcess::waitForProcessToFinish (const int timeoutMs) const
     {
         if (! isRunning())
             return true;
+
+        Thread::sleep (1);
     }
     while (timeoutMs < 0 || Time::getMillisecondCounter() < timeoutTime);
 
@@ -79,10 +81,122 @@ public:
         expect (p.start ("ls /"));
        #endif
 
-        //String output (p.readAllProcessOutput());
-        //expect (output.isNotEmpty());
+        String output (p.readAllProcessOutput());
+        expect (output.isNotEmpty());
+        expect (p.waitForProcessToFinish (10000));
+        expectEquals ((int) p.getExitCode(), 0);
+      #endif
+
+      #if JUCE_MAC || JUCE_LINUX
+        beginTest ("Separate output streams");
+
+        {
+            StringArray args;
+            args.add ("/bin/sh");
+            args.add ("-c");
+            args.add ("echo out; echo err >&2; exit 3");
+
+            ChildProcess p2;
+            expect (p2.start (args, ChildProcess::wantStdOut | ChildProcess::wantStdErr));
+
+            char buffer [64] = { 0 };
+            expectEquals (p2.readProcessOutput (buffer, sizeof (buffer) - 1), 4);
+            expectEquals (String (buffer), String ("out\n"));
+
+            zeromem (buffer, sizeof (buffer));
+            expectEquals (p2.readProcessErrorOutput (buffer, sizeof (buffer) - 1), 4);
+            expectEquals (String (buffer), String ("err\n"));
+
+            expect (p2.waitForProcessToFinish (10000));
+            expectEquals ((int) p2.getExitCode(), 3);
+        }
+
+        beginTest ("Large error output while reading standard output");
+
+        {
+            // (writes much more than a pipe can hold to stderr before writing to stdout)
+            StringArray args;
+            args.add ("/bin/sh");
+            args.add ("-c");
+            args.add ("i=0; while [ $i -lt 4000 ]; do echo 0123456789012345678901234567890123456789 >&2; i=$((i+1)); done; echo done");
+
+            ChildProcess p4;
+            expect (p4.start (args, ChildProcess::wantStdOut | ChildProcess::wantStdErr));
+            expectEquals (p4.readAllProcessOutput(), String ("done\n"));
+
+            MemoryOutputStream errorOutput;
+            char buffer [1024];
+
+            for (;;)
+            {
+                const int num = p4.readProcessErrorOutput (buffer, sizeof (buffer));
+
+                if (num <= 0)
+                    break;
+
+                errorOutput.write (buffer, (size_t) num);
+            }
+
+            expectEquals ((int) errorOutput.getDataSize(), 4000 * 41);
+            expect (p4.waitForProcessToFinish (10000));
+        }
+
+        beginTest ("Non-blocking reads");
+
+        {
+            ChildProcess p3;
+            expect (p3.start ("sleep 0.2"));
+
+            char buffer [64];
+            expectEquals (p3.readAvailableProcessOutput (buffer, sizeof (buffer)), 0);
+            expect (p3.waitForProcessToFinish (10000));
+            expectEquals (p3.readAvailableProcessOutput (buffer, sizeof (buffer)), -1);
+        }
+
+        beginTest ("Concurrent launches");
+
+        {
+            OwnedArray<LauncherThread> threads;
+
+            for (int i = 0; i < 4; ++i)
+                threads.add (new LauncherThread());
+
+            for (int i = 0; i < threads.size(); ++i)
+                threads.getUnchecked(i)->startThread();
+
+            for (int i = 0; i < threads.size(); ++i)
+            {
+                expect (threads.getUnchecked(i)->waitForThreadToExit (60000));
+                expectEquals (threads.getUnchecked(i)->numFailures, 0);
+            }
+        }
       #endif
     }
+
+private:
+    // Launches lots of short-lived processes - if any pipe handles leaked into the other
+    // threads' children, their reads wouldn't finish until those children had exited.
+    class LauncherThread  : public Thread
+    {
+    public:
+        LauncherThread() : Thread ("ChildProcess test"), numFailures (0) {}
+
+        void run()
+        {
+            for (int i = 0; i < 50; ++i)
+            {
+                ChildProcess p;
+
+                if (! (p.start ("echo hello")
+                        && p.readAllProcessOutput() == "hello\n"
+                        && p.waitForProcessToFinish (10000)
+                        && p.getExitCode() == 0))
+                    ++numFailures;
+            }
+        }
+
+        int numFailures;
+    };
 };
 
 static ChildProcessTests childProcessUnitTests;
@@ -48,24 +48,74 @@ public:
     */
     ~ChildProcess();
 
+    /** These flags are used by the start() methods to choose which of the child
+        process's output streams should be captured.
+    */
+    enum StreamFlags
+    {
+        wantStdOut = 1,     /**< Captures the process's standard output, for readProcessOutput(). */
+        wantStdErr = 2      /**< Captures its error output, for readProcessErrorOutput(). */
+    };
+
     /** Attempts to launch a child process command.
 
         The command should be the name of the executable file, followed by any arguments
         that are required.
         If the process has already been launched, this will launch it again. If a problem
         occurs, the method will return false.
+
+        The streamFlags should be a combination of values from the StreamFlags enum. Any
+        streams that aren't captured are shared with this process. On Windows, both
+        streams are always captured, and mixed together in the standard output.
+
+        If both streams are captured, then while a read from one of them is waiting for
+        data, anything that the process writes to the other one is kept in a buffer until
+        it's read, so a process that writes a lot of error output won't get stuck while
+        you're reading its standard output (e.g. with readAllProcessOutput()).
     */
-    bool start (const String& command);
+    bool start (const String& command, int streamFlags = wantStdOut);
+
+    /** Attempts to launch a child process, using a list of arguments rather than a command
+        string which would have to be split up.
+
+        The first item in the array is the executable, and the rest are its arguments.
+        @see start
+    */
+    bool start (const StringArray& arguments, int streamFlags = wantStdOut);
 
     /** Returns true if the child process is alive. */
     bool isRunning() const;
 
     /** Attempts to read some output from the child process.
         This will attempt to read up to the given number of bytes of data from the
-        process. It returns the number of bytes that were actually read.
+        process. It returns the number of bytes that were actually read, which will
+        only be less than the number requested if the process has closed its output.
     */
     int readProcessOutput (void* destBuffer, int numBytesToRead);
 
+    /** Attempts to read some of the error output from the child process.
+        This works like readProcessOutput(), but needs the process to have been started
+        with the wantStdErr flag.
+    */
+    int readProcessErrorOutput (void* destBuffer, int numBytesToRead);
+
+    /** Reads whatever output is available without waiting for any more.
+
+        This is handy for polling the process from a timer callback, or for watching
+        lots of processes from one thread. It returns the number of bytes that were
+        read, which may be 0 if there's nothing waiting, or -1 if the stream has been
+        closed and there's nothing more to read.
+
+        If readErrorOutput is true, this reads from the error output instead of the
+        standard output.
+    */
+    int readAvailableProcessOutput (void* destBuffer, int maxBytesToRead, bool readErrorOutput = false);
+
+    /** Returns the process's exit code.
+        This is only meaningful once isRunning() has returned false.
+    */
+    uint32 getExitCode() const;
+
     /** Blocks until the process has finished, and then returns its complete output
         as a string.
     */
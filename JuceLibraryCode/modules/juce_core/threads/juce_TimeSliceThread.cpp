@@ -23,15 +23,41 @@
   ==============================================================================
 */
 
-TimeSliceThread::TimeSliceThread (const String& threadName)
+class TimeSliceThread::Worker  : public Thread
+{
+public:
+    Worker (TimeSliceThread& owner_)
+        : Thread (owner_.getThreadName()), owner (owner_)
+    {
+    }
+
+    ~Worker()
+    {
+        stopThread (2000);
+    }
+
+    void run()
+    {
+        owner.serviceClients (*this);
+    }
+
+private:
+    TimeSliceThread& owner;
+
+    JUCE_DECLARE_NON_COPYABLE (Worker);
+};
+
+//==============================================================================
+TimeSliceThread::TimeSliceThread (const String& threadName, const int numberOfWorkerThreads)
     : Thread (threadName),
-      clientBeingCalled (nullptr)
+      numWorkerThreads (jmax (1, numberOfWorkerThreads))
 {
 }
 
 TimeSliceThread::~TimeSliceThread()
 {
     stopThread (2000);
+    stopWorkers();
 }
 
 //==============================================================================
@@ -40,30 +66,57 @@ void TimeSliceThread::addTimeSliceClient (TimeSliceClient* const client, int mil
     if (client != nullptr)
     {
         const ScopedLock sl (listLock);
-        client->nextCallTime = Time::getCurrentTime() + RelativeTime::milliseconds (millisecondsBeforeStarting);
-        clients.addIfNotAlreadyThere (client);
-        notify();
+        const uint32 callTime = Time::getMillisecondCounter() + (uint32) jmax (0, millisecondsBeforeStarting);
+
+        if (! clients.contains (client))
+        {
+            clients.add (client);
+            client->numTimeSlices = 0;
+            client->totalSliceTime = 0;
+            client->longestSliceTime = 0;
+        }
+
+        if (clientsBeingCalled.contains (client))
+        {
+            // Queueing the client while its call is still running would let another worker call
+            // it at the same time, so the time is just noted, and when the call returns, it'll be
+            // queued for this time or the one it asks for, whichever is sooner.
+            if (! client->addedDuringCall || (int) (callTime - client->nextCallTime) < 0)
+                client->nextCallTime = callTime;
+
+            client->addedDuringCall = true;
+            return;
+        }
+
+        queue.removeValue (client);
+        client->nextCallTime = callTime;
+        addToQueue (client);
+
+        wakeUpWorkers();
     }
 }
 
 void TimeSliceThread::removeTimeSliceClient (TimeSliceClient* const client)
 {
-    const ScopedLock sl1 (listLock);
+    const ScopedLock sl (listLock);
 
-    // if there's a chance we're in the middle of calling this client, we need to
-    // also lock the outer lock..
-    if (clientBeingCalled == client)
-    {
-        const ScopedUnlock ul (listLock); // unlock first to get the order right..
+    clients.removeValue (client);
+    queue.removeValue (client);
 
-        const ScopedLock sl2 (callbackLock);
-        const ScopedLock sl3 (listLock);
+    if (client != nullptr)
+        client->addedDuringCall = false;
 
-        clients.removeValue (client);
-    }
-    else
+    // if the client is being called, we need to wait for that to finish, unless it's
+    // this thread that's calling it, i.e. the client is removing itself..
+    for (;;)
     {
-        clients.removeValue (client);
+        const int index = clientsBeingCalled.indexOf (client);
+
+        if (index < 0 || threadsCallingClients.getUnchecked (index) == Thread::getCurrentThreadId())
+            break;
+
+        const ScopedUnlock ul (listLock);
+        callFinished.wait (20);
     }
 }
 
@@ -71,10 +124,12 @@ void TimeSliceThread::moveToFrontOfQueue (TimeSliceClient* client)
 {
     const ScopedLock sl (listLock);
 
-    if (clients.contains (client))
+    if (queue.contains (client))
     {
-        client->nextCallTime = Time::getCurrentTime();
-        notify();
+        queue.removeValue (client);
+        client->nextCallTime = Time::getMillisecondCounter();
+        queue.insert (0, client);
+        wakeUpWorkers();
     }
 }
 
@@ -89,81 +144,180 @@ TimeSliceClient* TimeSliceThread::getClient (const int i) const
     return clients [i];
 }
 
+TimeSliceThread::ClientStatistics TimeSliceThread::getClientStatistics (TimeSliceClient* const client) const
+{
+    ClientStatistics stats = { 0, 0, 0 };
+
+    const ScopedLock sl (listLock);
+
+    if (clients.contains (client))
+    {
+        stats.numTimeSlices = client->numTimeSlices;
+        stats.totalMilliseconds = client->totalSliceTime;
+        stats.longestMilliseconds = client->longestSliceTime;
+    }
+
+    return stats;
+}
+
 //==============================================================================
-TimeSliceClient* TimeSliceThread::getNextClient (int index) const
+void TimeSliceThread::addToQueue (TimeSliceClient* const client)
 {
-    Time soonest;
-    TimeSliceClient* client = nullptr;
+    // (the counter can wrap around, so the times have to be compared by their difference)
+    int start = 0, end = queue.size();
 
-    for (int i = clients.size(); --i >= 0;)
+    while (start < end)
     {
-        TimeSliceClient* const c = clients.getUnchecked ((i + index) % clients.size());
+        const int middle = (start + end) / 2;
 
-        if (client == nullptr || c->nextCallTime < soonest)
-        {
-            client = c;
-            soonest = c->nextCallTime;
-        }
+        if ((int) (client->nextCallTime - queue.getUnchecked (middle)->nextCallTime) < 0)
+            end = middle;
+        else
+            start = middle + 1;
     }
 
-    return client;
+    // (clients that are due at the same time stay in the order they were added, so that
+    // busy clients which keep asking to be called again immediately take turns)
+    queue.insert (start, client);
 }
 
-void TimeSliceThread::run()
+void TimeSliceThread::wakeUpWorkers()
 {
-    int index = 0;
+    notify();
+
+    for (int i = workers.size(); --i >= 0;)
+        workers.getUnchecked (i)->notify();
+}
 
-    while (! threadShouldExit())
+void TimeSliceThread::serviceClients (Thread& worker)
+{
+    // (the workers also stop when this thread is told to, so that stopping it stops them all)
+    while (! (worker.threadShouldExit() || threadShouldExit()))
     {
+        TimeSliceClient* client = nullptr;
         int timeToWait = 500;
 
         {
-            Time nextClientTime;
+            const ScopedLock sl (listLock);
 
+            if (queue.size() > 0)
             {
-                const ScopedLock sl2 (listLock);
-
-                index = clients.size() > 0 ? ((index + 1) % clients.size()) : 0;
+                const int msUntilDue = (int) (queue.getUnchecked (0)->nextCallTime - Time::getMillisecondCounter());
 
-                TimeSliceClient* const firstClient = getNextClient (index);
-                if (firstClient != nullptr)
-                    nextClientTime = firstClient->nextCallTime;
+                if (msUntilDue <= 0)
+                {
+                    client = queue.getUnchecked (0);
+                    queue.remove (0);
+                    clientsBeingCalled.add (client);
+                    threadsCallingClients.add (Thread::getCurrentThreadId());
+                }
+                else
+                {
+                    timeToWait = jmin (timeToWait, msUntilDue);
+                }
             }
+        }
 
-            const Time now (Time::getCurrentTime());
+        if (client != nullptr)
+        {
+            const double startTime = Time::getMillisecondCounterHiRes();
+            const int msUntilNextCall = client->useTimeSlice();
+            const double timeTaken = Time::getMillisecondCounterHiRes() - startTime;
 
-            if (nextClientTime > now)
             {
-                timeToWait = (int) jmin ((int64) 500, (nextClientTime - now).inMilliseconds());
-            }
-            else
-            {
-                timeToWait = index == 0 ? 1 : 0;
+                const ScopedLock sl (listLock);
 
-                const ScopedLock sl (callbackLock);
+                const int index = clientsBeingCalled.indexOf (client);
+                clientsBeingCalled.remove (index);
+                threadsCallingClients.remove (index);
 
+                // (the client may have been removed while it was being called, and perhaps added again)
+                if (clients.contains (client) && ! queue.contains (client))
                 {
-                    const ScopedLock sl2 (listLock);
-                    clientBeingCalled = getNextClient (index);
+                    ++(client->numTimeSlices);
+                    client->totalSliceTime += timeTaken;
+                    client->longestSliceTime = jmax (client->longestSliceTime, timeTaken);
+
+                    if (client->addedDuringCall)
+                    {
+                        // it was added during the call, so it stays registered, and the time it
+                        // was added with only gets replaced if the client asks to be called sooner
+                        client->addedDuringCall = false;
+
+                        if (msUntilNextCall >= 0)
+                        {
+                            const uint32 requestedTime = Time::getMillisecondCounter() + (uint32) msUntilNextCall;
+
+                            if ((int) (requestedTime - client->nextCallTime) < 0)
+                                client->nextCallTime = requestedTime;
+                        }
+
+                        addToQueue (client);
+                    }
+                    else if (msUntilNextCall >= 0)
+                    {
+                        client->nextCallTime = Time::getMillisecondCounter() + (uint32) msUntilNextCall;
+                        addToQueue (client);
+                    }
+                    else
+                    {
+                        clients.removeValue (client);
+                    }
                 }
+            }
 
-                if (clientBeingCalled != nullptr)
-                {
-                    const int msUntilNextCall = clientBeingCalled->useTimeSlice();
+            callFinished.signal();
+        }
+        else
+        {
+            worker.wait (timeToWait);
+        }
+    }
+}
 
-                    const ScopedLock sl2 (listLock);
+void TimeSliceThread::run()
+{
+    stopWorkers(); // (in case any are left over from the last time the thread ran)
 
-                    if (msUntilNextCall >= 0)
-                        clientBeingCalled->nextCallTime += RelativeTime::milliseconds (msUntilNextCall);
-                    else
-                        clients.removeValue (clientBeingCalled);
+    {
+        const ScopedLock sl (listLock);
 
-                    clientBeingCalled = nullptr;
-                }
-            }
+        for (int i = 1; i < numWorkerThreads; ++i)
+        {
+            Worker* const w = new Worker (*this);
+            workers.add (w);
+            w->startThread();
         }
+    }
 
-        if (timeToWait > 0)
-            wait (timeToWait);
+    serviceClients (*this);
+
+    // The workers are only told to stop here. Waiting for them would eat into the timeout of
+    // whoever's stopping this thread, so they're joined by the destructor or the next run().
+    const ScopedLock sl (listLock);
+
+    for (int i = workers.size(); --i >= 0;)
+    {
+        workers.getUnchecked (i)->signalThreadShouldExit();
+        workers.getUnchecked (i)->notify();
     }
 }
+
+void TimeSliceThread::stopWorkers()
+{
+    OwnedArray<Worker> finishedWorkers;
+
+    {
+        const ScopedLock sl (listLock);
+        finishedWorkers.swapWithArray (workers);
+    }
+
+    for (int i = finishedWorkers.size(); --i >= 0;)
+    {
+        finishedWorkers.getUnchecked (i)->signalThreadShouldExit();
+        finishedWorkers.getUnchecked (i)->notify();
+    }
+
+    for (int i = finishedWorkers.size(); --i >= 0;)
+        finishedWorkers.getUnchecked (i)->stopThread (2000);
+}
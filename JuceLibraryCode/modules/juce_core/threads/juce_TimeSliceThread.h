@@ -28,6 +28,7 @@
 
 #include "juce_Thread.h"
 #include "../containers/juce_Array.h"
+#include "../containers/juce_OwnedArray.h"
 #include "../time/juce_Time.h"
 class TimeSliceThread;
 
@@ -47,6 +48,12 @@ class TimeSliceThread;
 class JUCE_API  TimeSliceClient
 {
 public:
+    /** Creates a client. */
+    TimeSliceClient() noexcept
+        : nextCallTime (0), numTimeSlices (0), totalSliceTime (0), longestSliceTime (0),
+          addedDuringCall (false)
+    {}
+
     /** Destructor. */
     virtual ~TimeSliceClient()   {}
 
@@ -70,7 +77,10 @@ public:
 
 private:
     friend class TimeSliceThread;
-    Time nextCallTime;
+    uint32 nextCallTime;
+    int numTimeSlices;
+    double totalSliceTime, longestSliceTime;
+    bool addedDuringCall;
 };
 
 
@@ -79,6 +89,15 @@ private:
     A thread that keeps a list of clients, and calls each one in turn, giving them
     all a chance to run some sort of short task.
 
+    The clients are kept in order of the time at which they next want to be called,
+    and the thread sleeps until the first one is due, rather than polling.
+
+    The thread can also be given some extra worker threads, so that a client which
+    takes a long time in its useTimeSlice() method won't hold up all the others. A
+    client is never called by more than one worker at once, but different clients may
+    be called at the same time, so only use more than one worker if your clients
+    don't rely on being called one at a time.
+
     @see TimeSliceClient, Thread
 */
 class JUCE_API  TimeSliceThread   : public Thread
@@ -90,8 +109,13 @@ public:
 
         When first created, the thread is not running. Use the startThread()
         method to start it.
+
+        If numberOfWorkerThreads is more than 1, the extra workers are started and
+        stopped along with this thread, and share its list of clients. Stopping this
+        thread tells the workers to stop, but doesn't wait for them - that's done
+        by the destructor, or when the thread is next started.
     */
-    explicit TimeSliceThread (const String& threadName);
+    explicit TimeSliceThread (const String& threadName, int numberOfWorkerThreads = 1);
 
     /** Destructor.
 
@@ -107,6 +131,10 @@ public:
 
         The client's callbacks will start after the number of milliseconds specified
         by millisecondsBeforeStarting (and this may happen before this method has returned).
+
+        If the client is already in the list, this changes the time of its next call. If it's
+        being called at the moment, it'll be called again no later than the time given here,
+        even if its useTimeSlice() method asks for a later time or to be removed.
     */
     void addTimeSliceClient (TimeSliceClient* client, int millisecondsBeforeStarting = 0);
 
@@ -129,6 +157,23 @@ public:
     /** Returns one of the registered clients. */
     TimeSliceClient* getClient (int index) const;
 
+    /** Returns the number of threads that are used to call the clients. */
+    int getNumWorkerThreads() const noexcept            { return numWorkerThreads; }
+
+    //==============================================================================
+    /** Some timing information about a client, as returned by getClientStatistics(). */
+    struct ClientStatistics
+    {
+        int numTimeSlices;              /**< The number of times the client has been called. */
+        double totalMilliseconds;       /**< The total time spent in its useTimeSlice() method. */
+        double longestMilliseconds;     /**< The longest time that a single call has taken. */
+    };
+
+    /** Returns the timing information for one of the registered clients.
+        If the client isn't registered, the values will all be zero.
+    */
+    ClientStatistics getClientStatistics (TimeSliceClient* client) const;
+
     //==============================================================================
    #ifndef DOXYGEN
     void run();
@@ -136,11 +181,20 @@ public:
 
     //==============================================================================
 private:
-    CriticalSection callbackLock, listLock;
-    Array <TimeSliceClient*> clients;
-    TimeSliceClient* clientBeingCalled;
-
-    TimeSliceClient* getNextClient (int index) const;
+    class Worker;
+    friend class Worker;
+
+    CriticalSection listLock;
+    Array <TimeSliceClient*> clients, queue, clientsBeingCalled;
+    Array <Thread::ThreadID> threadsCallingClients;
+    OwnedArray <Worker> workers;
+    WaitableEvent callFinished;
+    const int numWorkerThreads;
+
+    void addToQueue (TimeSliceClient*);
+    void wakeUpWorkers();
+    void stopWorkers();
+    void serviceClients (Thread&);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TimeSliceThread);
 };
@@ -23,28 +23,150 @@
   ==============================================================================
 */
 
-class AsyncUpdater::AsyncUpdaterMessage  : public CallbackMessage
+/*  Triggered updaters aren't posted as separate messages. Instead, they're pushed onto a
+    lock-free list which is shared by the whole process, and only the trigger that finds
+    the list empty posts a message. When that message arrives, it takes the whole list and
+    delivers every update in it, in the order in which they were triggered.
+*/
+class AsyncUpdater::AsyncUpdaterMessage  : public ReferenceCountedObject
 {
 public:
     AsyncUpdaterMessage (AsyncUpdater& owner_)
-        : owner (owner_)
+        : owner (owner_), nextPending (nullptr)
     {
     }
 
-    void messageCallback()
+    void trigger()
     {
-        if (shouldDeliver.compareAndSetBool (0, 1))
-            owner.handleAsyncUpdate();
+        if (shouldDeliver.compareAndSetBool (1, 0) && isQueued.compareAndSetBool (1, 0))
+            addToPendingList();
     }
 
     Atomic<int> shouldDeliver;
 
 private:
     AsyncUpdater& owner;
+    Atomic<int> isQueued;
+    AsyncUpdaterMessage* nextPending;
+
+    static Atomic<AsyncUpdaterMessage*> pendingList;
+
+    // (these are only used on the message thread)
+    static AsyncUpdaterMessage* undeliveredList;
+    static bool drainMessagePosted;
+
+    //==============================================================================
+    class BatchMessage  : public CallbackMessage
+    {
+    public:
+        BatchMessage (const bool isDrainMessage_)
+            : delivered (false), isDrainMessage (isDrainMessage_)
+        {}
+
+        ~BatchMessage()
+        {
+            // if the message got thrown away without being delivered, the list has to be
+            // emptied here, or no more messages would ever be posted for it
+            if (! delivered)
+            {
+                if (isDrainMessage)
+                    drainMessagePosted = false;
+
+                dispatchPendingList (false);
+            }
+        }
+
+        void messageCallback()
+        {
+            delivered = true;
+
+            if (isDrainMessage)
+                drainMessagePosted = false;
+
+            dispatchPendingList (true);
+        }
+
+    private:
+        bool delivered;
+        const bool isDrainMessage;
+
+        JUCE_DECLARE_NON_COPYABLE (BatchMessage);
+    };
+
+    //==============================================================================
+    void addToPendingList()
+    {
+        incReferenceCount(); // (the list keeps a reference until the update has been dispatched)
+
+        for (;;)
+        {
+            AsyncUpdaterMessage* const head = pendingList.get();
+            nextPending = head;
+
+            if (pendingList.compareAndSetBool (this, head))
+            {
+                if (head == nullptr)
+                    (new BatchMessage (false))->post();
+
+                return;
+            }
+        }
+    }
+
+    static void dispatchPendingList (const bool deliver)
+    {
+        // The list is built up backwards, so reverse it to deliver the oldest first. Items
+        // can't be pushed again until their isQueued flag is cleared, so this is safe.
+        AsyncUpdaterMessage* m = pendingList.exchange (nullptr);
+        AsyncUpdaterMessage* inOrder = nullptr;
+
+        while (m != nullptr)
+        {
+            AsyncUpdaterMessage* const next = m->nextPending;
+            m->nextPending = inOrder;
+            inOrder = m;
+            m = next;
+        }
+
+        // ..and add them after anything that an outer call is still waiting to deliver
+        AsyncUpdaterMessage** tail = &undeliveredList;
+
+        while (*tail != nullptr)
+            tail = &((*tail)->nextPending);
+
+        *tail = inOrder;
+
+        // The rest of the list stays in undeliveredList while each callback runs, so that if
+        // the callback runs a modal loop, the loop can deliver them rather than leaving them
+        // stuck until it returns.
+        while (undeliveredList != nullptr)
+        {
+            const ReferenceCountedObjectPtr<AsyncUpdaterMessage> current (undeliveredList);
+            current->decReferenceCount();
+
+            undeliveredList = current->nextPending;
+            current->isQueued.set (0);
+
+            if (deliver && current->shouldDeliver.compareAndSetBool (0, 1))
+            {
+                if (undeliveredList != nullptr && ! drainMessagePosted)
+                {
+                    drainMessagePosted = true;
+                    (new BatchMessage (true))->post();
+                }
+
+                current->owner.handleAsyncUpdate();
+            }
+        }
+    }
 
     JUCE_DECLARE_NON_COPYABLE (AsyncUpdaterMessage);
 };
 
+Atomic<AsyncUpdater::AsyncUpdaterMessage*> AsyncUpdater::AsyncUpdaterMessage::pendingList;
+AsyncUpdater::AsyncUpdaterMessage* AsyncUpdater::AsyncUpdaterMessage::undeliveredList = nullptr;
+bool AsyncUpdater::AsyncUpdaterMessage::drainMessagePosted = false;
+
 //==============================================================================
 AsyncUpdater::AsyncUpdater()
 {
@@ -64,8 +186,7 @@ AsyncUpdater::~AsyncUpdater()
 
 void AsyncUpdater::triggerAsyncUpdate()
 {
-    if (message->shouldDeliver.compareAndSetBool (1, 0))
-        message->post();
+    message->trigger();
 }
 
 void AsyncUpdater::cancelPendingUpdate() noexcept
@@ -86,3 +207,125 @@ bool AsyncUpdater::isUpdatePending() const noexcept
 {
     return message->shouldDeliver.value != 0;
 }
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS && JUCE_MODAL_LOOPS_PERMITTED && ! (JUCE_MAC || JUCE_IOS)
+
+class AsyncUpdaterTests  : public UnitTest
+{
+public:
+    AsyncUpdaterTests() : UnitTest ("AsyncUpdater") {}
+
+    class CountingUpdater  : public AsyncUpdater
+    {
+    public:
+        CountingUpdater (int& counter_) : counter (counter_) {}
+        void handleAsyncUpdate()    { ++counter; }
+
+    private:
+        int& counter;
+    };
+
+    class NestedLoopUpdater  : public AsyncUpdater
+    {
+    public:
+        NestedLoopUpdater (const int& otherCounter_)
+            : otherCounter (otherCounter_), otherCountDuringLoop (-1)
+        {}
+
+        void handleAsyncUpdate()
+        {
+            MessageManager::getInstance()->runDispatchLoopUntil (50);
+            otherCountDuringLoop = otherCounter;
+        }
+
+        const int& otherCounter;
+        int otherCountDuringLoop;
+    };
+
+    static void dispatchUntil (const int& counter, const int target)
+    {
+        const uint32 timeout = Time::getMillisecondCounter() + 10000;
+
+        while (counter < target && Time::getMillisecondCounter() < timeout)
+            MessageManager::getInstance()->runDispatchLoopUntil (1);
+    }
+
+    void runTest()
+    {
+        if (! MessageManager::getInstance()->isThisTheMessageThread())
+            return;
+
+        beginTest ("Coalescing and cancelling");
+
+        int counter = 0;
+
+        {
+            CountingUpdater a (counter), b (counter), c (counter);
+
+            a.triggerAsyncUpdate();
+            a.triggerAsyncUpdate();
+            b.triggerAsyncUpdate();
+            b.cancelPendingUpdate();
+            c.triggerAsyncUpdate();
+            c.cancelPendingUpdate();
+            c.triggerAsyncUpdate();
+            expect (a.isUpdatePending() && c.isUpdatePending() && ! b.isUpdatePending());
+
+            MessageManager::getInstance()->runDispatchLoopUntil (50);
+            expectEquals (counter, 2);
+
+            a.triggerAsyncUpdate();
+            a.handleUpdateNowIfNeeded();
+            expectEquals (counter, 3);
+
+            MessageManager::getInstance()->runDispatchLoopUntil (50);
+            expectEquals (counter, 3);
+        }
+
+        beginTest ("Delivery inside a nested message loop");
+
+        {
+            counter = 0;
+            NestedLoopUpdater a (counter);
+            CountingUpdater b (counter);
+
+            a.triggerAsyncUpdate();
+            b.triggerAsyncUpdate();
+
+            MessageManager::getInstance()->runDispatchLoopUntil (200);
+            expectEquals (a.otherCountDuringLoop, 1);
+            expectEquals (counter, 1);
+        }
+
+        beginTest ("Triggering 100000 updaters");
+
+        const int numUpdaters = 100000;
+        OwnedArray<CountingUpdater> updaters;
+        counter = 0;
+
+        for (int i = 0; i < numUpdaters; ++i)
+            updaters.add (new CountingUpdater (counter));
+
+        for (int frame = 1; frame <= 5; ++frame)
+        {
+            const double startTime = Time::getMillisecondCounterHiRes();
+
+            for (int i = 0; i < numUpdaters; ++i)
+                updaters.getUnchecked (i)->triggerAsyncUpdate();
+
+            const double triggerTime = Time::getMillisecondCounterHiRes();
+
+            dispatchUntil (counter, frame * numUpdaters);
+            expectEquals (counter, frame * numUpdaters);
+
+            logMessage ("Triggered in " + String (triggerTime - startTime, 1) + "ms, delivered in "
+                          + String (Time::getMillisecondCounterHiRes() - triggerTime, 1) + "ms");
+        }
+    }
+};
+
+static AsyncUpdaterTests asyncUpdaterTests;
+
+#endif
@@ -587,6 +587,22 @@ void Graphics::drawLine (const Line<float>& line, const float lineThickness) con
     fillPath (p);
 }
 
+void Graphics::drawPolyline (const Point<float>* const points, const int numPoints, const float lineThickness) const
+{
+    jassert (points != nullptr || numPoints <= 0);
+
+    if (numPoints > 1 && ! context->drawPolyline (points, numPoints, lineThickness))
+    {
+        Path p;
+        p.startNewSubPath (points[0]);
+
+        for (int i = 1; i < numPoints; ++i)
+            p.lineTo (points[i]);
+
+        strokePath (p, PathStrokeType (lineThickness));
+    }
+}
+
 void Graphics::drawDashedLine (const Line<float>& line, const float* const dashLengths,
                                const int numDashLengths, const float lineThickness, int n) const
 {
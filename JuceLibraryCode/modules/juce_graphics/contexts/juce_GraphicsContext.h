@@ -374,6 +374,18 @@ public:
     */
     void drawLine (const Line<float>& line, float lineThickness) const;
 
+    /** Draws a series of connected lines, e.g. for plotting a waveform or a graph.
+
+        This is intended for drawing thin lines through large numbers of points, and is much
+        faster than building a Path and stroking it. The lines are joined without any special
+        treatment of their corners, and runs of points that fall within the same pixel are
+        merged, so the time it takes depends on the number of pixels that are covered rather
+        than the number of points.
+
+        For thicker lines that need proper joints or end-caps, use strokePath() instead.
+    */
+    void drawPolyline (const Point<float>* points, int numPoints, float lineThickness = 1.0f) const;
+
     /** Draws a dashed line using a custom set of dash-lengths.
 
         @param line             the line to draw
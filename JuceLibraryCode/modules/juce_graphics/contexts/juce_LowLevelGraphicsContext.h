@@ -99,6 +99,7 @@ public:
     virtual void drawLine (const Line <float>& line) = 0;
     virtual void drawVerticalLine (int x, float top, float bottom) = 0;
     virtual void drawHorizontalLine (int y, float left, float right) = 0;
+    virtual bool drawPolyline (const Point<float>*, int /*numPoints*/, float /*lineThickness*/)   { return false; }
 
     virtual void setFont (const Font& newFont) = 0;
     virtual const Font& getFont() = 0;
@@ -1199,6 +1199,8 @@ public:
     ClipRegion_EdgeTable (const Rectangle<float>& r) : edgeTable (r) {}
     ClipRegion_EdgeTable (const RectangleList& r)    : edgeTable (r) {}
     ClipRegion_EdgeTable (const Rectangle<int>& bounds, const Path& p, const AffineTransform& t) : edgeTable (bounds, p, t) {}
+    ClipRegion_EdgeTable (const Rectangle<int>& bounds, const Point<float>* points, int numPoints, float thickness, const AffineTransform& t)
+        : edgeTable (bounds, points, numPoints, thickness, t) {}
     ClipRegion_EdgeTable (const ClipRegion_EdgeTable& other) : edgeTable (other.edgeTable) {}
 
     Ptr clone() const
@@ -1684,6 +1686,63 @@ private:
 
 }
 
+//==============================================================================
+namespace SoftwareRendererClasses
+{
+    /** Keeps the images from finished transparency layers, so that later layers drawn
+        with the same renderer can re-use them.
+    */
+    class LayerImagePool  : public ReferenceCountedObject
+    {
+    public:
+        LayerImagePool() {}
+
+        Image getImage (const int width, const int height)
+        {
+            int best = -1;
+
+            for (int i = images.size(); --i >= 0;)
+            {
+                const Image& im = images.getReference (i);
+
+                if (im.getWidth() >= width && im.getHeight() >= height
+                     && (best < 0 || im.getWidth() * im.getHeight() < images.getReference (best).getWidth()
+                                                                        * images.getReference (best).getHeight()))
+                    best = i;
+            }
+
+            if (best < 0)
+                return Image (Image::ARGB, width, height, true);
+
+            Image im (images.getReference (best));
+            images.remove (best);
+
+            const Image::BitmapData data (im, 0, 0, width, height, Image::BitmapData::writeOnly);
+
+            for (int y = 0; y < height; ++y)
+                zeromem (data.getLinePointer (y), (size_t) (width * data.pixelStride));
+
+            return im;
+        }
+
+        void releaseImage (const Image& im)
+        {
+            images.add (im);
+
+            if (images.size() > maxNumImages)
+                images.remove (0);
+        }
+
+        typedef ReferenceCountedObjectPtr<LayerImagePool> Ptr;
+
+    private:
+        Array<Image> images;
+        enum { maxNumImages = 4 };
+
+        JUCE_DECLARE_NON_COPYABLE (LayerImagePool);
+    };
+}
+
 //==============================================================================
 class LowLevelGraphicsSoftwareRenderer::SavedState
 {
@@ -1692,6 +1751,7 @@ public:
         : image (image_), clip (new SoftwareRendererClasses::ClipRegion_RectangleList (clip_)),
           transform (0, 0),
           interpolationQuality (Graphics::mediumResamplingQuality),
+          layerImages (new SoftwareRendererClasses::LayerImagePool()),
           transparencyLayerAlpha (1.0f)
     {
     }
@@ -1700,6 +1760,7 @@ public:
         : image (image_), clip (new SoftwareRendererClasses::ClipRegion_RectangleList (clip_)),
           transform (xOffset_, yOffset_),
           interpolationQuality (Graphics::mediumResamplingQuality),
+          layerImages (new SoftwareRendererClasses::LayerImagePool()),
           transparencyLayerAlpha (1.0f)
     {
     }
@@ -1708,6 +1769,7 @@ public:
         : image (other.image), clip (other.clip), transform (other.transform),
           font (other.font), fillType (other.fillType),
           interpolationQuality (other.interpolationQuality),
+          layerImages (other.layerImages),
           transparencyLayerAlpha (other.transparencyLayerAlpha)
     {
     }
@@ -1823,23 +1885,19 @@ public:
                                : Rectangle<int>();
     }
 
-    SavedState* beginTransparencyLayer (float opacity)
+    void beginTransparencyLayer (float opacity)
     {
-        SavedState* s = new SavedState (*this);
-
         if (clip != nullptr)
         {
             const Rectangle<int> layerBounds (clip->getClipBounds());
 
-            s->image = Image (Image::ARGB, layerBounds.getWidth(), layerBounds.getHeight(), true);
-            s->transparencyLayerAlpha = opacity;
-            s->transform.moveOriginInDeviceSpace (-layerBounds.getX(), -layerBounds.getY());
+            image = layerImages->getImage (layerBounds.getWidth(), layerBounds.getHeight());
+            transparencyLayerAlpha = opacity;
+            transform.moveOriginInDeviceSpace (-layerBounds.getX(), -layerBounds.getY());
 
-            s->cloneClipIfMultiplyReferenced();
-            s->clip->translate (-layerBounds.getPosition());
+            cloneClipIfMultiplyReferenced();
+            clip->translate (-layerBounds.getPosition());
         }
-
-        return s;
     }
 
     void endTransparencyLayer (SavedState& finishedLayerState)
@@ -1847,11 +1905,19 @@ public:
         if (clip != nullptr)
         {
             const Rectangle<int> layerBounds (clip->getClipBounds());
+            const Image& layerImage = finishedLayerState.image;
+
+            // (a re-used layer image may be bigger than the area that was drawn into)
+            const Image usedArea (layerImage.getWidth() > layerBounds.getWidth() || layerImage.getHeight() > layerBounds.getHeight()
+                                    ? layerImage.getClippedImage (Rectangle<int> (layerBounds.getWidth(), layerBounds.getHeight()))
+                                    : layerImage);
 
             const ScopedPointer<LowLevelGraphicsContext> g (image.createLowLevelContext());
             g->setOpacity (finishedLayerState.transparencyLayerAlpha);
-            g->drawImage (finishedLayerState.image, AffineTransform::translation ((float) layerBounds.getX(),
-                                                                                  (float) layerBounds.getY()));
+            g->drawImage (usedArea, AffineTransform::translation ((float) layerBounds.getX(),
+                                                                  (float) layerBounds.getY()));
+
+            layerImages->releaseImage (layerImage);
         }
     }
 
@@ -1920,6 +1986,13 @@ public:
             fillShape (new SoftwareRendererClasses::ClipRegion_EdgeTable (clip->getClipBounds(), path, transform.getTransformWith (t)), false);
     }
 
+    void drawPolyline (const Point<float>* const points, const int numPoints, const float lineThickness)
+    {
+        if (clip != nullptr)
+            fillShape (new SoftwareRendererClasses::ClipRegion_EdgeTable (clip->getClipBounds(), points, numPoints, lineThickness,
+                                                                          transform.getTransform()), false);
+    }
+
     void fillEdgeTable (const EdgeTable& edgeTable, const float x, const int y)
     {
         jassert (transform.isOnlyTranslated);
@@ -1992,7 +2065,6 @@ public:
         const AffineTransform t (transform.getTransformWith (trans));
 
         const Image::BitmapData destData (image, Image::BitmapData::readWrite);
-        const Image::BitmapData srcData (sourceImage, Image::BitmapData::readOnly);
         const int alpha = fillType.colour.getAlpha();
         const bool betterQuality = (interpolationQuality != Graphics::lowResamplingQuality);
 
@@ -2009,19 +2081,25 @@ public:
 
                 if (tiledFillClipRegion != nullptr)
                 {
+                    const Image::BitmapData srcData (sourceImage, Image::BitmapData::readOnly);
                     tiledFillClipRegion->renderImageUntransformed (destData, srcData, alpha, tx, ty, true);
                 }
                 else
                 {
                     Rectangle<int> area (tx, ty, sourceImage.getWidth(), sourceImage.getHeight());
-                    area = area.getIntersection (image.getBounds());
+                    area = area.getIntersection (image.getBounds()).getIntersection (clip->getClipBounds());
 
                     if (! area.isEmpty())
                     {
                         SoftwareRendererClasses::ClipRegionBase::Ptr c (clip->applyClipTo (new SoftwareRendererClasses::ClipRegion_EdgeTable (area)));
 
                         if (c != nullptr)
-                            c->renderImageUntransformed (destData, srcData, alpha, tx, ty, false);
+                        {
+                            // Only ask the source image for the part that's actually going to be drawn..
+                            const Image::BitmapData srcData (sourceImage, area.getX() - tx, area.getY() - ty,
+                                                             area.getWidth(), area.getHeight());
+                            c->renderImageUntransformed (destData, srcData, alpha, area.getX(), area.getY(), false);
+                        }
                     }
                 }
 
@@ -2034,10 +2112,20 @@ public:
 
         if (tiledFillClipRegion != nullptr)
         {
+            const Image::BitmapData srcData (sourceImage, Image::BitmapData::readOnly);
             tiledFillClipRegion->renderImageTransformed (destData, srcData, alpha, t, betterQuality, true);
         }
         else
         {
+            // Find the part of the source that lands inside the clip region, with a couple of
+            // pixels' margin for the interpolation, and only ask the image for that area..
+            const Rectangle<int> srcArea (clip->getClipBounds().toFloat().transformed (t.inverted())
+                                            .getSmallestIntegerContainer().expanded (2, 2)
+                                            .getIntersection (sourceImage.getBounds()));
+
+            if (srcArea.isEmpty())
+                return;
+
             Path p;
             p.addRectangle (sourceImage.getBounds());
 
@@ -2045,7 +2133,15 @@ public:
             c = c->clipToPath (p, t);
 
             if (c != nullptr)
-                c->renderImageTransformed (destData, srcData, alpha, t, betterQuality, false);
+            {
+                const Image::BitmapData srcData (sourceImage, srcArea.getX(), srcArea.getY(),
+                                                 srcArea.getWidth(), srcArea.getHeight());
+
+                c->renderImageTransformed (destData, srcData, alpha,
+                                           AffineTransform::translation ((float) srcArea.getX(), (float) srcArea.getY())
+                                                           .followedBy (t),
+                                           betterQuality, false);
+            }
         }
     }
 
@@ -2058,6 +2154,7 @@ public:
     Graphics::ResamplingQuality interpolationQuality;
 
 private:
+    SoftwareRendererClasses::LayerImagePool::Ptr layerImages;
     float transparencyLayerAlpha;
 
     void cloneClipIfMultiplyReferenced()
@@ -2205,6 +2302,12 @@ void LowLevelGraphicsSoftwareRenderer::drawHorizontalLine (const int y, float le
         savedState->fillRect (Rectangle<float> (left, (float) y, right - left, 1.0f));
 }
 
+bool LowLevelGraphicsSoftwareRenderer::drawPolyline (const Point<float>* const points, const int numPoints, const float lineThickness)
+{
+    savedState->drawPolyline (points, numPoints, lineThickness);
+    return true;
+}
+
 void LowLevelGraphicsSoftwareRenderer::drawGlyph (int glyphNumber, const AffineTransform& transform)
 {
     Font& f = savedState->font;
@@ -80,6 +80,7 @@ public:
 
     void drawVerticalLine (int x, float top, float bottom);
     void drawHorizontalLine (int x, float top, float bottom);
+    bool drawPolyline (const Point<float>* points, int numPoints, float lineThickness);
 
     void setFont (const Font&);
     const Font& getFont();
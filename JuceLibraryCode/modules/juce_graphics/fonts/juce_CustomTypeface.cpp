@@ -348,6 +348,73 @@ float CustomTypeface::getStringWidth (const String& text)
     return x;
 }
 
+void CustomTypeface::getStringWidths (const StringArray& strings, Array<float>& widths)
+{
+    // For each ASCII character, this keeps a row containing its advance when followed by each
+    // of the other ASCII characters, so that after the first few strings, measuring a string
+    // is just one table lookup per character rather than a glyph search and a kerning search.
+    enum { tableSize = 128 };
+    HeapBlock<float> spacings;
+    bool rowIsFilled [tableSize] = { false };
+
+    widths.ensureStorageAllocated (widths.size() + strings.size());
+
+    for (int i = 0; i < strings.size(); ++i)
+    {
+        String::CharPointerType t (strings[i].getCharPointer());
+        juce_wchar c = *t;
+        float x = 0;
+
+        while (c != 0)
+        {
+            ++t;
+            const juce_wchar next = *t;
+
+            if (((uint32) c) < tableSize && ((uint32) next) < tableSize)
+            {
+                if (! rowIsFilled [c])
+                {
+                    if (spacings == nullptr)
+                        spacings.malloc (tableSize * tableSize);
+
+                    float* const row = spacings + c * tableSize;
+                    const GlyphInfo* const glyph = findGlyph (c, true);
+
+                    if (glyph != nullptr)
+                    {
+                        for (int j = 0; j < tableSize; ++j)
+                            row[j] = glyph->getHorizontalSpacing ((juce_wchar) j);
+                    }
+                    else
+                    {
+                        const float w = getStringWidth (String::charToString (c));
+
+                        for (int j = 0; j < tableSize; ++j)
+                            row[j] = w;
+                    }
+
+                    rowIsFilled [c] = true;
+                }
+
+                x += spacings [c * tableSize + next];
+            }
+            else
+            {
+                const GlyphInfo* const glyph = findGlyph (c, true);
+
+                if (glyph != nullptr)
+                    x += glyph->getHorizontalSpacing (next);
+                else
+                    x += getStringWidth (String::charToString (c));
+            }
+
+            c = next;
+        }
+
+        widths.add (x);
+    }
+}
+
 void CustomTypeface::getGlyphPositions (const String& text, Array <int>& resultGlyphs, Array<float>& xOffsets)
 {
     xOffsets.add (0);
@@ -121,6 +121,7 @@ public:
     float getAscent() const;
     float getDescent() const;
     float getStringWidth (const String& text);
+    void getStringWidths (const StringArray& strings, Array<float>& widths);
     void getGlyphPositions (const String& text, Array <int>& glyphs, Array<float>& xOffsets);
     bool getOutlineForGlyph (int glyphNumber, Path& path);
     EdgeTable* getEdgeTableForGlyph (int glyphNumber, const AffineTransform& transform);
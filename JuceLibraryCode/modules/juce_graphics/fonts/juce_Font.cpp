@@ -606,6 +606,23 @@ float Font::getStringWidthFloat (const String& text) const
     return w * font->height * font->horizontalScale;
 }
 
+void Font::getStringWidths (const StringArray& strings, Array<float>& widths) const
+{
+    widths.clearQuick();
+    getTypeface()->getStringWidths (strings, widths);
+
+    const float scale = font->height * font->horizontalScale;
+    float* const w = widths.getRawDataPointer();
+
+    for (int i = widths.size(); --i >= 0;)
+    {
+        if (font->kerning != 0)
+            w[i] += font->kerning * strings[i].length();
+
+        w[i] *= scale;
+    }
+}
+
 void Font::getGlyphPositions (const String& text, Array <int>& glyphs, Array <float>& xOffsets) const
 {
     getTypeface()->getGlyphPositions (text, glyphs, xOffsets);
@@ -357,6 +357,17 @@ public:
     */
     float getStringWidthFloat (const String& text) const;
 
+    /** Measures the widths of a set of strings as they would be drawn using this font.
+
+        The array that's passed in is cleared, and then filled with the width of each
+        string, in the same order as the strings. The results are the same as calling
+        getStringWidthFloat() for each one, but this is much quicker for large numbers of
+        strings, e.g. when fitting the width of a column to its contents.
+
+        @see getStringWidthFloat
+    */
+    void getStringWidths (const StringArray& strings, Array<float>& widths) const;
+
     /** Returns the series of glyph numbers and their x offsets needed to represent a string.
 
         An extra x offset is added at the end of the run, to indicate where the right hand
@@ -38,6 +38,12 @@ Typeface::Ptr Typeface::getFallbackTypeface()
     return fallbackFont.getTypeface();
 }
 
+void Typeface::getStringWidths (const StringArray& strings, Array<float>& widths)
+{
+    for (int i = 0; i < strings.size(); ++i)
+        widths.add (getStringWidth (strings[i]));
+}
+
 EdgeTable* Typeface::getEdgeTableForGlyph (int glyphNumber, const AffineTransform& transform)
 {
     Path path;
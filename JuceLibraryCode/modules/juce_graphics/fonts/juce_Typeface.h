@@ -102,6 +102,16 @@ public:
     */
     virtual float getStringWidth (const String& text) = 0;
 
+    /** Measures the widths of a set of strings.
+
+        The widths are appended to the array that's passed in, in the same order as the strings,
+        and are based on the font having an normalised height of 1.0. The default implementation
+        just calls getStringWidth() for each one, but typefaces may be able to do this more quickly.
+
+        You should never need to call this directly! Use Font::getStringWidths() instead!
+    */
+    virtual void getStringWidths (const StringArray& strings, Array<float>& widths);
+
     /** Converts a line of text into its glyph numbers and their positions.
 
         The distances returned are based on the font having an normalised height of 1.0.
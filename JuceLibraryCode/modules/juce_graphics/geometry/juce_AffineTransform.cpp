@@ -241,6 +241,12 @@ bool AffineTransform::isOnlyTranslation() const noexcept
         && (mat11 == 1.0f);
 }
 
+bool AffineTransform::isOnlyScaleAndTranslation() const noexcept
+{
+    return (mat01 == 0)
+        && (mat10 == 0);
+}
+
 float AffineTransform::getScaleFactor() const noexcept
 {
     return juce_hypot (mat00 + mat01, mat10 + mat11);
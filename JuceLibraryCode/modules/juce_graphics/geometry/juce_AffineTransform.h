@@ -237,6 +237,10 @@ public:
     */
     float getTranslationY() const noexcept                  { return mat12; }
 
+    /** Returns true if the transform only scales and translates the points, and doesn't
+        rotate or shear them. */
+    bool isOnlyScaleAndTranslation() const noexcept;
+
     /** Returns the approximate scale factor by which lengths will be transformed.
         Obviously a length may be scaled by entirely different amounts depending on its
         direction, so this is only appropriate as a rough guide.
@@ -42,63 +42,105 @@ EdgeTable::EdgeTable (const Rectangle<int>& bounds_,
         t += lineStrideElements;
     }
 
-    const int leftLimit   = bounds.getX() << 8;
-    const int topLimit    = bounds.getY() << 8;
-    const int rightLimit  = bounds.getRight() << 8;
-    const int heightLimit = bounds.getHeight() << 8;
-
     PathFlatteningIterator iter (path, transform);
 
     while (iter.next())
+        addEdgeLine (iter.x1, iter.y1, iter.x2, iter.y2);
+
+    sanitiseLevels (path.isUsingNonZeroWinding());
+}
+
+//==============================================================================
+namespace EdgeTableHelpers
+{
+    /** Accumulates a run of consecutive polyline points which all lie within a thin
+        horizontal or vertical strip, so that the run can be drawn as a single segment.
+    */
+    struct PolylineRun
     {
-        int y1 = roundToInt (iter.y1 * 256.0f);
-        int y2 = roundToInt (iter.y2 * 256.0f);
+        PolylineRun (const Point<float>& start) noexcept
+            : first (start), last (start), minX (start), maxX (start), minY (start), maxY (start), numPoints (1)
+        {}
+
+        bool canAdd (const Point<float>& p, const float tolerance) const noexcept
+        {
+            return jmax (maxX.getX(), p.getX()) - jmin (minX.getX(), p.getX()) < tolerance
+                || jmax (maxY.getY(), p.getY()) - jmin (minY.getY(), p.getY()) < tolerance;
+        }
 
-        if (y1 != y2)
+        void add (const Point<float>& p) noexcept
         {
-            y1 -= topLimit;
-            y2 -= topLimit;
+            if (p.getX() < minX.getX())  minX = p;
+            if (p.getX() > maxX.getX())  maxX = p;
+            if (p.getY() < minY.getY())  minY = p;
+            if (p.getY() > maxY.getY())  maxY = p;
 
-            const int startY = y1;
-            int direction = -1;
+            last = p;
+            ++numPoints;
+        }
 
-            if (y1 > y2)
+        /** Returns the line that the run can be replaced by. */
+        Line<float> getLine (const float tolerance) const noexcept
+        {
+            if (numPoints > 2)
             {
-                std::swap (y1, y2);
-                direction = 1;
+                const bool isThin = maxX.getX() - minX.getX() < tolerance;
+                const bool isFlat = maxY.getY() - minY.getY() < tolerance;
+
+                if (isThin && ! isFlat)     return Line<float> (minY, maxY);
+                if (isFlat && ! isThin)     return Line<float> (minX, maxX);
             }
 
-            if (y1 < 0)
-                y1 = 0;
+            return Line<float> (first, last);
+        }
 
-            if (y2 > heightLimit)
-                y2 = heightLimit;
+        Point<float> first, last, minX, maxX, minY, maxY;
+        int numPoints;
+    };
+}
 
-            if (y1 < y2)
-            {
-                const double startX = 256.0f * iter.x1;
-                const double multiplier = (iter.x2 - iter.x1) / (iter.y2 - iter.y1);
-                const int stepSize = jlimit (1, 256, 256 / (1 + (int) std::abs (multiplier)));
+EdgeTable::EdgeTable (const Rectangle<int>& bounds_, const Point<float>* const points, const int numPoints,
+                      const float lineThickness, const AffineTransform& transform)
+   : bounds (bounds_),
+     maxEdgesPerLine (juce_edgeTableDefaultEdgesPerLine),
+     lineStrideElements ((juce_edgeTableDefaultEdgesPerLine << 1) + 1),
+     needToCheckEmptinesss (true)
+{
+    table.malloc ((size_t) ((bounds.getHeight() + 1) * lineStrideElements));
+    int* t = table;
 
-                do
-                {
-                    const int step = jmin (stepSize, y2 - y1, 256 - (y1 & 255));
-                    int x = roundToInt (startX + multiplier * ((y1 + (step >> 1)) - startY));
+    for (int i = bounds.getHeight(); --i >= 0;)
+    {
+        *t = 0;
+        t += lineStrideElements;
+    }
 
-                    if (x < leftLimit)
-                        x = leftLimit;
-                    else if (x >= rightLimit)
-                        x = rightLimit - 1;
+    if (numPoints < 2)
+        return;
 
-                    addEdgePoint (x, y1 >> 8, direction * step);
-                    y1 += step;
-                }
-                while (y1 < y2);
-            }
+    // (runs of points closer together than this are merged into a single segment)
+    const float tolerance = 0.5f;
+    const float halfThickness = 0.5f * lineThickness
+                                  * std::sqrt (std::abs (transform.mat00 * transform.mat11 - transform.mat01 * transform.mat10));
+
+    EdgeTableHelpers::PolylineRun run (points[0].transformedBy (transform));
+
+    for (int i = 1; i < numPoints; ++i)
+    {
+        const Point<float> p (points[i].transformedBy (transform));
+
+        if (run.numPoints > 1 && ! run.canAdd (p, tolerance))
+        {
+            addPolylineSegment (run.getLine (tolerance), halfThickness);
+            run = EdgeTableHelpers::PolylineRun (run.last);
         }
+
+        run.add (p);
     }
 
-    sanitiseLevels (path.isUsingNonZeroWinding());
+    addPolylineSegment (run.getLine (tolerance), halfThickness);
+
+    sanitiseLevels (true);
 }
 
 EdgeTable::EdgeTable (const Rectangle<int>& rectangleToAdd)
@@ -348,6 +390,84 @@ void EdgeTable::optimiseTable()
     remapTableForNumEdges (maxLineElements);
 }
 
+void EdgeTable::addEdgeLine (const float x1, const float y1, const float x2, const float y2)
+{
+    int top = roundToInt (y1 * 256.0f);
+    int bottom = roundToInt (y2 * 256.0f);
+
+    if (top != bottom)
+    {
+        const int leftLimit   = bounds.getX() << 8;
+        const int rightLimit  = bounds.getRight() << 8;
+        const int heightLimit = bounds.getHeight() << 8;
+
+        top -= bounds.getY() << 8;
+        bottom -= bounds.getY() << 8;
+
+        const int startY = top;
+        int direction = -1;
+
+        if (top > bottom)
+        {
+            std::swap (top, bottom);
+            direction = 1;
+        }
+
+        if (top < 0)
+            top = 0;
+
+        if (bottom > heightLimit)
+            bottom = heightLimit;
+
+        if (top < bottom)
+        {
+            const double startX = 256.0f * x1;
+            const double multiplier = (x2 - x1) / (y2 - y1);
+            const int stepSize = jlimit (1, 256, 256 / (1 + (int) std::abs (multiplier)));
+
+            do
+            {
+                const int step = jmin (stepSize, bottom - top, 256 - (top & 255));
+                int x = roundToInt (startX + multiplier * ((top + (step >> 1)) - startY));
+
+                if (x < leftLimit)
+                    x = leftLimit;
+                else if (x >= rightLimit)
+                    x = rightLimit - 1;
+
+                addEdgePoint (x, top >> 8, direction * step);
+                top += step;
+            }
+            while (top < bottom);
+        }
+    }
+}
+
+void EdgeTable::addPolylineSegment (const Line<float>& line, const float halfThickness)
+{
+    const Point<float> start (line.getStart()), end (line.getEnd());
+    const float length = line.getLength();
+
+    if (length <= 0.0f)
+        return;
+
+    if (jmax (start.getX(), end.getX()) + halfThickness < bounds.getX()
+         || jmin (start.getX(), end.getX()) - halfThickness > bounds.getRight()
+         || jmax (start.getY(), end.getY()) + halfThickness < bounds.getY()
+         || jmin (start.getY(), end.getY()) - halfThickness > bounds.getBottom())
+        return;
+
+    const Point<float> across ((end.getY() - start.getY()) * (-halfThickness / length),
+                               (end.getX() - start.getX()) * (halfThickness / length));
+
+    const Point<float> p1 (start + across), p2 (end + across), p3 (end - across), p4 (start - across);
+
+    addEdgeLine (p1.getX(), p1.getY(), p2.getX(), p2.getY());
+    addEdgeLine (p2.getX(), p2.getY(), p3.getX(), p3.getY());
+    addEdgeLine (p3.getX(), p3.getY(), p4.getX(), p4.getY());
+    addEdgeLine (p4.getX(), p4.getY(), p1.getX(), p1.getY());
+}
+
 void EdgeTable::addEdgePoint (const int x, const int y, const int winding)
 {
     jassert (y >= 0 && y < bounds.getHeight());
@@ -29,6 +29,7 @@
 #include "../geometry/juce_AffineTransform.h"
 #include "../geometry/juce_Rectangle.h"
 #include "../geometry/juce_RectangleList.h"
+#include "../geometry/juce_Line.h"
 class Path;
 class Image;
 
@@ -56,6 +57,24 @@ public:
                const Path& pathToAdd,
                const AffineTransform& transform);
 
+    /** Creates an edge table containing a series of connected lines.
+
+        Each line is drawn as a rectangle of the given thickness, with no special treatment
+        of the corners where they join. Runs of points that lie within a fraction of a pixel of each
+        other are merged into single lines, so that very dense polylines (e.g. a waveform with
+        many points per pixel) only create as many edges as there are pixels to cover.
+
+        @param clipLimits               only the region of the lines that lies within this area will be added
+        @param points                   the points to join
+        @param numPoints                the number of points in the array
+        @param lineThickness            the thickness of the lines, before the transform is applied
+        @param transform                a transform to apply to the points
+    */
+    EdgeTable (const Rectangle<int>& clipLimits,
+               const Point<float>* points, int numPoints,
+               float lineThickness,
+               const AffineTransform& transform);
+
     /** Creates an edge table containing a rectangle. */
     explicit EdgeTable (const Rectangle<int>& rectangleToAdd);
 
@@ -198,6 +217,8 @@ private:
     bool needToCheckEmptinesss;
 
     void addEdgePoint (int x, int y, int winding);
+    void addEdgeLine (float x1, float y1, float x2, float y2);
+    void addPolylineSegment (const Line<float>& line, float halfThickness);
     void remapTableForNumEdges (int newNumEdgesPerLine);
     void intersectWithEdgeTableLine (int y, const int* otherLine);
     void clipEdgeTableLineToRange (int* line, int x1, int x2) noexcept;
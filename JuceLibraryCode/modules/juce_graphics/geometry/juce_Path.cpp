@@ -61,6 +61,14 @@ const float Path::quadMarker           = 100003.0f;
 const float Path::cubicMarker          = 100004.0f;
 const float Path::closeSubPathMarker   = 100005.0f;
 
+int Path::getNumCoordinatesFor (const float marker) noexcept
+{
+    if (marker == cubicMarker)          return 6;
+    if (marker == quadMarker)           return 4;
+    if (marker == closeSubPathMarker)   return 0;
+    return 2;
+}
+
 //==============================================================================
 Path::PathBounds::PathBounds() noexcept
     : pathXMin (0), pathXMax (0), pathYMin (0), pathYMax (0)
@@ -116,6 +124,488 @@ void Path::PathBounds::extend (const float x1, const float y1, const float x2, c
     }
 }
 
+//==============================================================================
+/*  A flattened copy of a path, made with a particular tolerance, and indexed so that
+    the lines near a point can be found without looking at all of them.
+
+    The lines are taken in runs of branchSize, and a tree of bounding boxes is built over
+    these runs, where each box encloses branchSize boxes of the level below. The runs are
+    sorted along a Z-order curve before building the tree, so that the boxes stay small
+    even when consecutive parts of the path are far apart. For contains(), the lines are
+    also sorted into horizontal bands, so that only the lines that cross the point's band
+    need to be checked.
+*/
+struct Path::FlattenedPath
+{
+    FlattenedPath (const Path& path, const float tolerance_)
+        : tolerance (tolerance_), length (0), next (nullptr),
+          magnitude (0), numBands (0), bandTop (0), bandScale (0)
+    {
+        PathFlatteningIterator i (path, AffineTransform::identity, tolerance);
+
+        while (i.next())
+        {
+            const Line<float> line (i.x1, i.y1, i.x2, i.y2);
+            lines.add (line);
+            distances.add (length);
+            length += line.getLength();
+        }
+
+        buildBoxes();
+        buildBands();
+    }
+
+    ~FlattenedPath()
+    {
+        delete next;
+    }
+
+    //==============================================================================
+    bool contains (const float x, const float y, const bool useNonZeroWinding) const noexcept
+    {
+        int positiveCrossings = 0;
+        int negativeCrossings = 0;
+
+        if (numBands > 0)
+        {
+            const int band = getBand (y);
+
+            for (int n = bandStarts.getUnchecked (band); n < bandStarts.getUnchecked (band + 1); ++n)
+            {
+                const Line<float>& l = lines.getReference (bandLines.getUnchecked (n));
+                const float x1 = l.getStartX(), y1 = l.getStartY();
+                const float x2 = l.getEndX(),   y2 = l.getEndY();
+
+                if ((y1 <= y && y2 > y) || (y2 <= y && y1 > y))
+                {
+                    const float intersectX = x1 + (x2 - x1) * (y - y1) / (y2 - y1);
+
+                    if (intersectX <= x)
+                    {
+                        if (y1 < y2)
+                            ++positiveCrossings;
+                        else
+                            ++negativeCrossings;
+                    }
+                }
+            }
+        }
+
+        return useNonZeroWinding ? (negativeCrossings != positiveCrossings)
+                                 : ((negativeCrossings + positiveCrossings) & 1) != 0;
+    }
+
+    // Calls visitor.visit (lineIndex, line) for the lines whose bounding boxes overlap the
+    // given line's, until it returns false. The lines aren't visited in any particular order.
+    template <class Visitor>
+    void visitLinesNear (const Line<float>& line, Visitor& visitor) const
+    {
+        if (lines.size() > 0)
+        {
+            PathBounds area;
+            area.reset (line.getStartX(), line.getStartY());
+            area.extend (line.getEndX(), line.getEndY());
+
+            // (a bit of slack, in case rounding errors make lines that only touch appear to cross)
+            const float slack = getSlack (jmax (std::abs (area.pathXMin), std::abs (area.pathXMax),
+                                                std::abs (area.pathYMin), std::abs (area.pathYMax)));
+            area.pathXMin -= slack;
+            area.pathYMin -= slack;
+            area.pathXMax += slack;
+            area.pathYMax += slack;
+
+            visitNode (levelStarts.size() - 1, 0, area, visitor);
+        }
+    }
+
+    Point<float> getPointAlongPath (const float distanceFromStart) const noexcept
+    {
+        // find the first line that ends at or beyond this distance..
+        int start = 0, end = lines.size();
+
+        while (start < end)
+        {
+            const int mid = (start + end) / 2;
+
+            if (distanceFromStart <= getDistanceToEndOf (mid))
+                end = mid;
+            else
+                start = mid + 1;
+        }
+
+        if (start < lines.size())
+            return lines.getReference (start).getPointAlongLine (distanceFromStart - distances.getUnchecked (start));
+
+        return lines.size() > 0 ? lines.getReference (lines.size() - 1).getEnd() : Point<float>();
+    }
+
+    float getNearestPoint (const Point<float>& targetPoint, Point<float>& pointOnPath) const
+    {
+        if (lines.size() == 0)
+            return 0;
+
+        NearestLine nearest (targetPoint, getSlack (jmax (std::abs (targetPoint.x), std::abs (targetPoint.y))));
+
+        // (start with the lines in the target's band, which will usually include one that's
+        // close enough to let the search skip most of the tree)
+        const int band = getBand (targetPoint.y);
+
+        for (int n = bandStarts.getUnchecked (band); n < bandStarts.getUnchecked (band + 1); ++n)
+            checkLine (bandLines.getUnchecked (n), nearest);
+
+        findNearest (levelStarts.size() - 1, 0, nearest);
+
+        pointOnPath = nearest.point;
+        return distances.getUnchecked (nearest.index)
+                 + nearest.point.getDistanceFrom (lines.getReference (nearest.index).getStart());
+    }
+
+    //==============================================================================
+    const float tolerance;
+    float length;
+    FlattenedPath* next;
+
+private:
+    enum { branchSize = 8 };
+
+    Array<Line<float> > lines;
+    Array<float> distances;     // the distance along the path at which each line starts
+    float magnitude;
+
+    Array<PathBounds> boxes;    // all the levels of the tree, starting with the boxes around the runs of lines
+    Array<int> levelStarts;     // the index in boxes at which each level starts
+    Array<int> runStarts;       // the first line in each of the bottom level's boxes
+
+    int numBands;
+    float bandTop, bandScale;
+    Array<int> bandStarts, bandLines;
+
+    float getDistanceToEndOf (const int lineIndex) const noexcept
+    {
+        return lineIndex < lines.size() - 1 ? distances.getUnchecked (lineIndex + 1) : length;
+    }
+
+    float getSlack (const float otherMagnitude) const noexcept
+    {
+        return (magnitude + otherMagnitude + 1.0f) * 1.0e-5f;
+    }
+
+    int getLevelSize (const int level) const noexcept
+    {
+        return (level < levelStarts.size() - 1 ? levelStarts.getUnchecked (level + 1) : boxes.size())
+                 - levelStarts.getUnchecked (level);
+    }
+
+    //==============================================================================
+    struct Run
+    {
+        PathBounds box;
+        int firstLine;
+        uint32 key;
+    };
+
+    struct RunComparator
+    {
+        static int compareElements (const Run& first, const Run& second) noexcept
+        {
+            return first.key < second.key ? -1 : (first.key > second.key ? 1 : 0);
+        }
+    };
+
+    static uint32 spreadBits (uint32 n) noexcept
+    {
+        n = (n | (n << 8)) & 0x00ff00ff;
+        n = (n | (n << 4)) & 0x0f0f0f0f;
+        n = (n | (n << 2)) & 0x33333333;
+        return (n | (n << 1)) & 0x55555555;
+    }
+
+    void buildBoxes()
+    {
+        if (lines.size() == 0)
+            return;
+
+        Array<Run> runs;
+        runs.ensureStorageAllocated (lines.size() / branchSize + 1);
+
+        PathBounds area;
+        area.reset (lines.getReference (0).getStartX(), lines.getReference (0).getStartY());
+
+        for (int i = 0; i < lines.size(); i += branchSize)
+        {
+            Run run;
+            run.firstLine = i;
+            run.box.reset (lines.getReference (i).getStartX(), lines.getReference (i).getStartY());
+
+            for (int j = i; j < jmin (i + branchSize, lines.size()); ++j)
+            {
+                const Line<float>& l = lines.getReference (j);
+                run.box.extend (l.getStartX(), l.getStartY(), l.getEndX(), l.getEndY());
+            }
+
+            area.extend (run.box.pathXMin, run.box.pathYMin, run.box.pathXMax, run.box.pathYMax);
+            runs.add (run);
+        }
+
+        magnitude = jmax (std::abs (area.pathXMin), std::abs (area.pathXMax),
+                          std::abs (area.pathYMin), std::abs (area.pathYMax));
+
+        const float scaleX = area.pathXMax > area.pathXMin ? 65535.0f / (area.pathXMax - area.pathXMin) : 0.0f;
+        const float scaleY = area.pathYMax > area.pathYMin ? 65535.0f / (area.pathYMax - area.pathYMin) : 0.0f;
+
+        for (int i = runs.size(); --i >= 0;)
+        {
+            Run& run = runs.getReference (i);
+            const uint32 x = (uint32) jlimit (0.0f, 65535.0f, ((run.box.pathXMin + run.box.pathXMax) * 0.5f - area.pathXMin) * scaleX);
+            const uint32 y = (uint32) jlimit (0.0f, 65535.0f, ((run.box.pathYMin + run.box.pathYMax) * 0.5f - area.pathYMin) * scaleY);
+            run.key = spreadBits (x) | (spreadBits (y) << 1);
+        }
+
+        RunComparator comparator;
+        runs.sort (comparator);
+
+        boxes.ensureStorageAllocated (runs.size() + runs.size() / (branchSize - 1) + 1);
+        runStarts.ensureStorageAllocated (runs.size());
+
+        for (int i = 0; i < runs.size(); ++i)
+        {
+            boxes.add (runs.getReference (i).box);
+            runStarts.add (runs.getReference (i).firstLine);
+        }
+
+        levelStarts.add (0);
+
+        while (getLevelSize (levelStarts.size() - 1) > 1)
+        {
+            const int levelStart = levelStarts.getLast();
+            const int levelEnd = boxes.size();
+            levelStarts.add (levelEnd);
+
+            for (int i = levelStart; i < levelEnd; i += branchSize)
+            {
+                PathBounds b (boxes.getUnchecked (i));
+
+                for (int j = i + 1; j < jmin (i + branchSize, levelEnd); ++j)
+                {
+                    const PathBounds& child = boxes.getReference (j);
+                    b.extend (child.pathXMin, child.pathYMin, child.pathXMax, child.pathYMax);
+                }
+
+                boxes.add (b);
+            }
+        }
+    }
+
+    //==============================================================================
+    int getBand (const float y) const noexcept
+    {
+        const float pos = (y - bandTop) * bandScale;
+        return pos > 0 ? jmin (numBands - 1, (int) jmin (pos, (float) numBands)) : 0;
+    }
+
+    void buildBands()
+    {
+        const int numLines = lines.size();
+
+        if (numLines == 0)
+            return;
+
+        const PathBounds& area = boxes.getReference (boxes.size() - 1);
+        bandTop = area.pathYMin;
+        numBands = jlimit (1, 4096, numLines / 4);
+
+        HeapBlock<int> lineBands ((size_t) numLines * 2);
+        int numEntries;
+
+        // (if lots of the lines are tall, use fewer bands, so that the index doesn't get too big)
+        for (;;)
+        {
+            bandScale = area.pathYMax > area.pathYMin ? numBands / (area.pathYMax - area.pathYMin) : 0.0f;
+            numEntries = 0;
+
+            const Line<float>* l = lines.getRawDataPointer();
+            int* bands = lineBands;
+
+            for (int i = numLines; --i >= 0; ++l)
+            {
+                const float y1 = l->getStartY(), y2 = l->getEndY();
+                const int firstBand = getBand (jmin (y1, y2));
+                const int lastBand  = getBand (jmax (y1, y2));
+                *bands++ = firstBand;
+                *bands++ = lastBand;
+                numEntries += lastBand - firstBand + 1;
+            }
+
+            if (numEntries <= numLines * 8 || numBands == 1)
+                break;
+
+            numBands /= 2;
+        }
+
+        bandStarts.insertMultiple (0, 0, numBands + 1);
+        bandLines.insertMultiple (0, 0, numEntries);
+        int* const starts = bandStarts.getRawDataPointer();
+
+        for (int i = 0; i < numLines; ++i)
+            for (int band = lineBands [i * 2]; band <= lineBands [i * 2 + 1]; ++band)
+                ++starts [band + 1];
+
+        for (int band = 0; band < numBands; ++band)
+            starts [band + 1] += starts [band];
+
+        HeapBlock<int> nextEntry ((size_t) numBands);
+        memcpy (nextEntry, starts, sizeof (int) * (size_t) numBands);
+        int* const entries = bandLines.getRawDataPointer();
+
+        for (int i = 0; i < numLines; ++i)
+            for (int band = lineBands [i * 2]; band <= lineBands [i * 2 + 1]; ++band)
+                entries [nextEntry [band]++] = i;
+    }
+
+    //==============================================================================
+    template <class Visitor>
+    bool visitNode (const int level, const int index, const PathBounds& area, Visitor& visitor) const
+    {
+        const PathBounds& b = boxes.getReference (levelStarts.getUnchecked (level) + index);
+
+        if (b.pathXMax < area.pathXMin || b.pathXMin > area.pathXMax
+             || b.pathYMax < area.pathYMin || b.pathYMin > area.pathYMax)
+            return true;
+
+        if (level == 0)
+        {
+            const int first = runStarts.getUnchecked (index);
+
+            for (int i = first; i < jmin (first + branchSize, lines.size()); ++i)
+                if (! visitor.visit (i, lines.getReference (i)))
+                    return false;
+        }
+        else
+        {
+            const int first = index * branchSize;
+
+            for (int i = first; i < jmin (first + branchSize, getLevelSize (level - 1)); ++i)
+                if (! visitNode (level - 1, i, area, visitor))
+                    return false;
+        }
+
+        return true;
+    }
+
+    //==============================================================================
+    struct NearestLine
+    {
+        NearestLine (const Point<float>& target_, const float slack_) noexcept
+            : target (target_), distance (std::numeric_limits<float>::max()), slack (slack_), index (0)
+        {}
+
+        const Point<float> target;
+        Point<float> point;
+        float distance;
+        const float slack;
+        int index;
+    };
+
+    static float getDistance (const PathBounds& b, const Point<float>& p) noexcept
+    {
+        const float dx = jmax (0.0f, b.pathXMin - p.x, p.x - b.pathXMax);
+        const float dy = jmax (0.0f, b.pathYMin - p.y, p.y - b.pathYMax);
+        return juce_hypot (dx, dy);
+    }
+
+    void checkLine (const int index, NearestLine& nearest) const noexcept
+    {
+        Point<float> pointOnLine;
+        const float distance = lines.getReference (index).getDistanceFromPoint (nearest.target, pointOnLine);
+
+        // (if two lines are equally near, the earlier one wins)
+        if (distance < nearest.distance || (distance == nearest.distance && index < nearest.index))
+        {
+            nearest.distance = distance;
+            nearest.point = pointOnLine;
+            nearest.index = index;
+        }
+    }
+
+    void findNearest (const int level, const int index, NearestLine& nearest) const
+    {
+        if (level == 0)
+        {
+            const int first = runStarts.getUnchecked (index);
+
+            for (int i = first; i < jmin (first + branchSize, lines.size()); ++i)
+                checkLine (i, nearest);
+        }
+        else
+        {
+            // visit the nearest boxes first, and skip any that are further away than the best line so far
+            const int first = index * branchSize;
+            const int childStart = levelStarts.getUnchecked (level - 1);
+            const int numChildren = jmin ((int) branchSize, getLevelSize (level - 1) - first);
+            int children [branchSize];
+            float childDistances [branchSize];
+
+            for (int i = 0; i < numChildren; ++i)
+            {
+                const float distance = getDistance (boxes.getReference (childStart + first + i), nearest.target);
+                int j = i;
+
+                for (; j > 0 && childDistances [j - 1] > distance; --j)
+                {
+                    children [j] = children [j - 1];
+                    childDistances [j] = childDistances [j - 1];
+                }
+
+                children [j] = first + i;
+                childDistances [j] = distance;
+            }
+
+            for (int i = 0; i < numChildren && childDistances [i] <= nearest.distance + nearest.slack; ++i)
+                findNearest (level - 1, children [i], nearest);
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (FlattenedPath);
+};
+
+const Path::FlattenedPath& Path::getFlattenedPath (const float tolerance, ScopedPointer<FlattenedPath>& uncachedPath) const
+{
+    int numCached = 0;
+
+    for (FlattenedPath* f = flattenedPaths.get(); f != nullptr; f = f->next)
+    {
+        if (f->tolerance == tolerance)
+            return *f;
+
+        ++numCached;
+    }
+
+    // (if lots of different tolerances are being used, just make a temporary one)
+    if (numCached >= 4)
+    {
+        uncachedPath = new FlattenedPath (*this, tolerance);
+        return *uncachedPath;
+    }
+
+    FlattenedPath* const newPath = new FlattenedPath (*this, tolerance);
+
+    for (;;)
+    {
+        newPath->next = flattenedPaths.get();
+
+        if (flattenedPaths.compareAndSetBool (newPath, newPath->next))
+            return *newPath;
+    }
+}
+
+void Path::clearFlattenedPaths() noexcept
+{
+    // (a plain read is enough here: nothing can be reading the path while it's being modified,
+    // and this gets called for every element that's added, so it needs to avoid a locked op)
+    if (flattenedPaths.value != nullptr)
+        delete flattenedPaths.exchange (nullptr);
+}
+
 //==============================================================================
 Path::Path()
    : numElements (0), useNonZeroWinding (true)
@@ -124,6 +614,7 @@ Path::Path()
 
 Path::~Path()
 {
+    clearFlattenedPaths();
 }
 
 Path::Path (const Path& other)
@@ -142,6 +633,7 @@ Path& Path::operator= (const Path& other)
 {
     if (this != &other)
     {
+        clearFlattenedPaths();
         data.ensureAllocatedSize ((int) other.numElements);
 
         numElements = other.numElements;
@@ -160,12 +652,15 @@ Path::Path (Path&& other) noexcept
     : data (static_cast <ArrayAllocationBase <float, DummyCriticalSection>&&> (other.data)),
       numElements (other.numElements),
       bounds (other.bounds),
-      useNonZeroWinding (other.useNonZeroWinding)
+      useNonZeroWinding (other.useNonZeroWinding),
+      flattenedPaths (other.flattenedPaths.exchange (nullptr))
 {
 }
 
 Path& Path::operator= (Path&& other) noexcept
 {
+    clearFlattenedPaths();
+    flattenedPaths = other.flattenedPaths.exchange (nullptr);
     data = static_cast <ArrayAllocationBase <float, DummyCriticalSection>&&> (other.data);
     numElements = other.numElements;
     bounds = other.bounds;
@@ -193,6 +688,7 @@ bool Path::operator!= (const Path& other) const noexcept
 
 void Path::clear() noexcept
 {
+    clearFlattenedPaths();
     numElements = 0;
     bounds.reset();
 }
@@ -206,6 +702,7 @@ void Path::swapWithPath (Path& other) noexcept
     std::swap (bounds.pathYMin, other.bounds.pathYMin);
     std::swap (bounds.pathYMax, other.bounds.pathYMax);
     std::swap (useNonZeroWinding, other.useNonZeroWinding);
+    flattenedPaths = other.flattenedPaths.exchange (flattenedPaths.get());
 }
 
 //==============================================================================
@@ -266,6 +763,7 @@ void Path::startNewSubPath (const float x, const float y)
 
     data.ensureAllocatedSize ((int) numElements + 3);
 
+    clearFlattenedPaths();
     data.elements [numElements++] = moveMarker;
     data.elements [numElements++] = x;
     data.elements [numElements++] = y;
@@ -285,6 +783,7 @@ void Path::lineTo (const float x, const float y)
 
     data.ensureAllocatedSize ((int) numElements + 3);
 
+    clearFlattenedPaths();
     data.elements [numElements++] = lineMarker;
     data.elements [numElements++] = x;
     data.elements [numElements++] = y;
@@ -308,6 +807,7 @@ void Path::quadraticTo (const float x1, const float y1,
 
     data.ensureAllocatedSize ((int) numElements + 5);
 
+    clearFlattenedPaths();
     data.elements [numElements++] = quadMarker;
     data.elements [numElements++] = x1;
     data.elements [numElements++] = y1;
@@ -337,6 +837,7 @@ void Path::cubicTo (const float x1, const float y1,
 
     data.ensureAllocatedSize ((int) numElements + 7);
 
+    clearFlattenedPaths();
     data.elements [numElements++] = cubicMarker;
     data.elements [numElements++] = x1;
     data.elements [numElements++] = y1;
@@ -363,6 +864,7 @@ void Path::closeSubPath()
     if (numElements > 0
          && data.elements [numElements - 1] != closeSubPathMarker)
     {
+        clearFlattenedPaths();
         data.ensureAllocatedSize ((int) numElements + 1);
         data.elements [numElements++] = closeSubPathMarker;
     }
@@ -417,6 +919,7 @@ void Path::addRectangle (const float x, const float y,
         bounds.pathYMax = jmax (bounds.pathYMax, y2);
     }
 
+    clearFlattenedPaths();
     data.elements [numElements++] = moveMarker;
     data.elements [numElements++] = x1;
     data.elements [numElements++] = y2;
@@ -863,54 +1366,75 @@ void Path::addPath (const Path& other,
 //==============================================================================
 void Path::applyTransform (const AffineTransform& transform) noexcept
 {
-    bounds.reset();
-    bool firstPoint = true;
+    clearFlattenedPaths();
+
+    if (numElements == 0)
+    {
+        bounds.reset();
+        return;
+    }
+
+    // (working on local copies lets the compiler keep these in registers, as it can't
+    // otherwise tell that writing to the path's data won't change them)
+    const AffineTransform t (transform);
     float* d = data.elements;
     float* const end = d + numElements;
 
-    while (d < end)
+    if (t.isOnlyScaleAndTranslation())
     {
-        const float type = *d++;
+        // without any rotation, the corners of the bounds stay as the extreme points, so the
+        // new bounds can just be transformed along with the points
+        const float sx = t.mat00, sy = t.mat11, dx = t.mat02, dy = t.mat12;
 
-        if (type == moveMarker)
+        while (d < end)
         {
-            transform.transformPoint (d[0], d[1]);
+            for (int i = getNumCoordinatesFor (*d++) / 2; --i >= 0; d += 2)
+            {
+                d[0] = sx * d[0] + dx;
+                d[1] = sy * d[1] + dy;
+            }
+        }
 
-            if (firstPoint)
+        const float x1 = sx * bounds.pathXMin + dx, x2 = sx * bounds.pathXMax + dx;
+        const float y1 = sy * bounds.pathYMin + dy, y2 = sy * bounds.pathYMax + dy;
+        bounds.reset (x1, y1);
+        bounds.extend (x2, y2);
+    }
+    else
+    {
+        PathBounds b;
+        b.reset (t.mat00 * d[1] + t.mat01 * d[2] + t.mat02,
+                 t.mat10 * d[1] + t.mat11 * d[2] + t.mat12);
+
+        while (d < end)
+        {
+            const float type = *d++;
+
+            if (type == lineMarker || type == moveMarker)
             {
-                firstPoint = false;
-                bounds.reset (d[0], d[1]);
+                t.transformPoint (d[0], d[1]);
+                b.extend (d[0], d[1]);
+                d += 2;
             }
-            else
+            else if (type == quadMarker)
             {
-                bounds.extend (d[0], d[1]);
+                t.transformPoints (d[0], d[1], d[2], d[3]);
+                b.extend (d[0], d[1], d[2], d[3]);
+                d += 4;
+            }
+            else if (type == cubicMarker)
+            {
+                t.transformPoints (d[0], d[1], d[2], d[3], d[4], d[5]);
+                b.extend (d[0], d[1], d[2], d[3]);
+                b.extend (d[4], d[5]);
+                d += 6;
             }
-
-            d += 2;
-        }
-        else if (type == lineMarker)
-        {
-            transform.transformPoint (d[0], d[1]);
-            bounds.extend (d[0], d[1]);
-            d += 2;
-        }
-        else if (type == quadMarker)
-        {
-            transform.transformPoints (d[0], d[1], d[2], d[3]);
-            bounds.extend (d[0], d[1], d[2], d[3]);
-            d += 4;
-        }
-        else if (type == cubicMarker)
-        {
-            transform.transformPoints (d[0], d[1], d[2], d[3], d[4], d[5]);
-            bounds.extend (d[0], d[1], d[2], d[3]);
-            bounds.extend (d[4], d[5]);
-            d += 6;
         }
+
+        bounds = b;
     }
 }
 
-
 //==============================================================================
 AffineTransform Path::getTransformToScaleToFit (const float x, const float y,
                                                 const float w, const float h,
@@ -971,81 +1495,93 @@ bool Path::contains (const float x, const float y, const float tolerance) const
          || y <= bounds.pathYMin || y >= bounds.pathYMax)
         return false;
 
-    PathFlatteningIterator i (*this, AffineTransform::identity, tolerance);
+    ScopedPointer<FlattenedPath> uncachedPath;
+    return getFlattenedPath (tolerance, uncachedPath).contains (x, y, useNonZeroWinding);
+}
 
-    int positiveCrossings = 0;
-    int negativeCrossings = 0;
+bool Path::contains (const Point<float>& point, const float tolerance) const
+{
+    return contains (point.x, point.y, tolerance);
+}
 
-    while (i.next())
+namespace PathHelpers
+{
+    struct LineIntersectionFinder
+    {
+        LineIntersectionFinder (const Line<float>& line_) noexcept : line (line_), found (false) {}
+
+        bool visit (int, const Line<float>& l) noexcept
+        {
+            Point<float> intersection;
+            found = line.intersects (l, intersection);
+            return ! found;
+        }
+
+        const Line<float>& line;
+        bool found;
+    };
+
+    struct LineClipper
     {
-        if ((i.y1 <= y && i.y2 > y) || (i.y2 <= y && i.y1 > y))
+        LineClipper (const Line<float>& line_, const bool keepStart_) noexcept
+            : line (line_), result (line_), keepStart (keepStart_), lastLineIndex (-1) {}
+
+        bool visit (const int lineIndex, const Line<float>& l) noexcept
         {
-            const float intersectX = i.x1 + (i.x2 - i.x1) * (y - i.y1) / (i.y2 - i.y1);
+            Point<float> intersection;
 
-            if (intersectX <= x)
+            // (the lines arrive in no particular order, but it's the last crossing along the path that counts)
+            if (lineIndex > lastLineIndex && line.intersects (l, intersection))
             {
-                if (i.y1 < i.y2)
-                    ++positiveCrossings;
+                lastLineIndex = lineIndex;
+
+                if (keepStart)
+                    result.setEnd (intersection);
                 else
-                    ++negativeCrossings;
+                    result.setStart (intersection);
             }
+
+            return true;
         }
-    }
 
-    return useNonZeroWinding ? (negativeCrossings != positiveCrossings)
-                             : ((negativeCrossings + positiveCrossings) & 1) != 0;
-}
-
-bool Path::contains (const Point<float>& point, const float tolerance) const
-{
-    return contains (point.x, point.y, tolerance);
+        const Line<float>& line;
+        Line<float> result;
+        const bool keepStart;
+        int lastLineIndex;
+    };
 }
 
 bool Path::intersectsLine (const Line<float>& line, const float tolerance)
 {
-    PathFlatteningIterator i (*this, AffineTransform::identity, tolerance);
-    Point<float> intersection;
-
-    while (i.next())
-        if (line.intersects (Line<float> (i.x1, i.y1, i.x2, i.y2), intersection))
-            return true;
-
-    return false;
+    ScopedPointer<FlattenedPath> uncachedPath;
+    PathHelpers::LineIntersectionFinder finder (line);
+    getFlattenedPath (tolerance, uncachedPath).visitLinesNear (line, finder);
+    return finder.found;
 }
 
 Line<float> Path::getClippedLine (const Line<float>& line, const bool keepSectionOutsidePath) const
 {
-    Line<float> result (line);
     const bool startInside = contains (line.getStart());
     const bool endInside   = contains (line.getEnd());
 
     if (startInside == endInside)
-    {
-        if (keepSectionOutsidePath == startInside)
-            result = Line<float>();
-    }
-    else
-    {
-        PathFlatteningIterator i (*this, AffineTransform::identity);
-        Point<float> intersection;
-
-        while (i.next())
-        {
-            if (line.intersects (Line<float> (i.x1, i.y1, i.x2, i.y2), intersection))
-            {
-                if ((startInside && keepSectionOutsidePath) || (endInside && ! keepSectionOutsidePath))
-                    result.setStart (intersection);
-                else
-                    result.setEnd (intersection);
-            }
-        }
-    }
+        return keepSectionOutsidePath == startInside ? Line<float>() : line;
 
-    return result;
+    ScopedPointer<FlattenedPath> uncachedPath;
+    PathHelpers::LineClipper clipper (line, (startInside && ! keepSectionOutsidePath)
+                                              || (endInside && keepSectionOutsidePath));
+    getFlattenedPath (PathFlatteningIterator::defaultTolerance, uncachedPath).visitLinesNear (line, clipper);
+    return clipper.result;
 }
 
 float Path::getLength (const AffineTransform& transform) const
 {
+    if (transform.isIdentity())
+    {
+        ScopedPointer<FlattenedPath> uncachedPath;
+        return getFlattenedPath (PathFlatteningIterator::defaultTolerance, uncachedPath).length;
+    }
+
     float length = 0;
     PathFlatteningIterator i (*this, transform);
 
@@ -1057,6 +1593,12 @@ float Path::getLength (const AffineTransform& transform) const
 
 Point<float> Path::getPointAlongPath (float distanceFromStart, const AffineTransform& transform) const
 {
+    if (transform.isIdentity())
+    {
+        ScopedPointer<FlattenedPath> uncachedPath;
+        return getFlattenedPath (PathFlatteningIterator::defaultTolerance, uncachedPath).getPointAlongPath (distanceFromStart);
+    }
+
     PathFlatteningIterator i (*this, transform);
 
     while (i.next())
@@ -1076,6 +1618,12 @@ Point<float> Path::getPointAlongPath (float distanceFromStart, const AffineTrans
 float Path::getNearestPoint (const Point<float>& targetPoint, Point<float>& pointOnPath,
                              const AffineTransform& transform) const
 {
+    if (transform.isIdentity())
+    {
+        ScopedPointer<FlattenedPath> uncachedPath;
+        return getFlattenedPath (PathFlatteningIterator::defaultTolerance, uncachedPath).getNearestPoint (targetPoint, pointOnPath);
+    }
+
     PathFlatteningIterator i (*this, transform);
     float bestPosition = 0, bestDistance = std::numeric_limits<float>::max();
     float length = 0;
@@ -1568,3 +2116,281 @@ bool Path::Iterator::next()
 }
 
 #undef JUCE_CHECK_COORDS_ARE_VALID
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PathTests  : public UnitTest
+{
+public:
+    PathTests() : UnitTest ("Path") {}
+
+    // These are the straightforward versions of the queries, which walk every line of the
+    // flattened path, to check the answers that come from the cached, indexed copy.
+    static bool referenceContains (const Path& path, const float x, const float y)
+    {
+        // (this uses the same default tolerance as Path::contains())
+        const Rectangle<float> bounds (path.getBounds());
+
+        if (x <= bounds.getX() || x >= bounds.getRight() || y <= bounds.getY() || y >= bounds.getBottom())
+            return false;
+
+        PathFlatteningIterator i (path, AffineTransform::identity, 1.0f);
+        int positiveCrossings = 0, negativeCrossings = 0;
+
+        while (i.next())
+        {
+            if ((i.y1 <= y && i.y2 > y) || (i.y2 <= y && i.y1 > y))
+            {
+                const float intersectX = i.x1 + (i.x2 - i.x1) * (y - i.y1) / (i.y2 - i.y1);
+
+                if (intersectX <= x)
+                {
+                    if (i.y1 < i.y2)
+                        ++positiveCrossings;
+                    else
+                        ++negativeCrossings;
+                }
+            }
+        }
+
+        return path.isUsingNonZeroWinding() ? (negativeCrossings != positiveCrossings)
+                                            : ((negativeCrossings + positiveCrossings) & 1) != 0;
+    }
+
+    static Point<float> referencePointAlongPath (const Path& path, float distanceFromStart)
+    {
+        PathFlatteningIterator i (path);
+
+        while (i.next())
+        {
+            const Line<float> line (i.x1, i.y1, i.x2, i.y2);
+
+            if (distanceFromStart <= line.getLength())
+                return line.getPointAlongLine (distanceFromStart);
+
+            distanceFromStart -= line.getLength();
+        }
+
+        return Point<float> (i.x2, i.y2);
+    }
+
+    static float referenceNearestDistance (const Path& path, const Point<float>& target)
+    {
+        PathFlatteningIterator i (path);
+        float bestDistance = std::numeric_limits<float>::max();
+        Point<float> pointOnLine;
+
+        while (i.next())
+            bestDistance = jmin (bestDistance, Line<float> (i.x1, i.y1, i.x2, i.y2).getDistanceFromPoint (target, pointOnLine));
+
+        return bestDistance;
+    }
+
+    static Line<float> referenceClippedLine (const Path& path, const Line<float>& line, const bool keepSectionOutsidePath)
+    {
+        const bool startInside = referenceContains (path, line.getStartX(), line.getStartY());
+        const bool endInside   = referenceContains (path, line.getEndX(), line.getEndY());
+
+        if (startInside == endInside)
+            return keepSectionOutsidePath == startInside ? Line<float>() : line;
+
+        Line<float> result (line);
+        PathFlatteningIterator i (path);
+        Point<float> intersection;
+
+        while (i.next())
+        {
+            if (line.intersects (Line<float> (i.x1, i.y1, i.x2, i.y2), intersection))
+            {
+                if ((startInside && keepSectionOutsidePath) || (endInside && ! keepSectionOutsidePath))
+                    result.setStart (intersection);
+                else
+                    result.setEnd (intersection);
+            }
+        }
+
+        return result;
+    }
+
+    static Point<float> randomPointNear (const Rectangle<float>& area, Random& r)
+    {
+        return Point<float> (area.getX() - 10.0f + r.nextFloat() * (area.getWidth() + 20.0f),
+                             area.getY() - 10.0f + r.nextFloat() * (area.getHeight() + 20.0f));
+    }
+
+    void expectNear (const Point<float>& p1, const Point<float>& p2, const float tolerance)
+    {
+        expect (p1.getDistanceFrom (p2) <= tolerance,
+                p1.toString() + " != " + p2.toString());
+    }
+
+    void checkQueries (const Path& path, Random& r)
+    {
+        const Rectangle<float> area (path.getBounds());
+        const float length = path.getLength();
+        const float tolerance = 1.0e-3f * (1.0f + jmax (area.getWidth(), area.getHeight(), length));
+
+        for (int i = 0; i < 200; ++i)
+        {
+            const Point<float> p (randomPointNear (area, r));
+            expect (path.contains (p) == referenceContains (path, p.x, p.y));
+
+            Point<float> pointOnPath;
+            path.getNearestPoint (p, pointOnPath);
+            expect (std::abs (p.getDistanceFrom (pointOnPath) - referenceNearestDistance (path, p)) <= tolerance);
+
+            const float distance = r.nextFloat() * length * 1.1f;
+            expectNear (path.getPointAlongPath (distance), referencePointAlongPath (path, distance), tolerance);
+
+            const Line<float> line (p, randomPointNear (area, r));
+            const bool keepOutside = r.nextBool();
+            const Line<float> clipped (path.getClippedLine (line, keepOutside));
+            const Line<float> expected (referenceClippedLine (path, line, keepOutside));
+            expectNear (clipped.getStart(), expected.getStart(), tolerance);
+            expectNear (clipped.getEnd(), expected.getEnd(), tolerance);
+        }
+    }
+
+    void checkTransform (const Path& original, const AffineTransform& t)
+    {
+        Path transformed (original);
+        transformed.applyTransform (t);
+
+        Path::Iterator i1 (original), i2 (transformed);
+        bool allMatch = true;
+        float minX = 0, minY = 0, maxX = 0, maxY = 0;
+        bool isFirstPoint = true;
+
+        while (i1.next() && i2.next())
+        {
+            const int numPoints = i1.elementType == Path::Iterator::cubicTo ? 3
+                                    : (i1.elementType == Path::Iterator::quadraticTo ? 2
+                                        : (i1.elementType == Path::Iterator::closePath ? 0 : 1));
+
+            const float* const x1[] = { &i1.x1, &i1.x2, &i1.x3 };
+            const float* const y1[] = { &i1.y1, &i1.y2, &i1.y3 };
+            const float* const x2[] = { &i2.x1, &i2.x2, &i2.x3 };
+            const float* const y2[] = { &i2.y1, &i2.y2, &i2.y3 };
+
+            for (int i = 0; i < numPoints; ++i)
+            {
+                float x = *x1[i], y = *y1[i];
+                t.transformPoint (x, y);
+                allMatch = allMatch && x == *x2[i] && y == *y2[i];
+
+                minX = isFirstPoint ? x : jmin (minX, x);
+                maxX = isFirstPoint ? x : jmax (maxX, x);
+                minY = isFirstPoint ? y : jmin (minY, y);
+                maxY = isFirstPoint ? y : jmax (maxY, y);
+                isFirstPoint = false;
+            }
+        }
+
+        expect (allMatch);
+
+        const Rectangle<float> expectedBounds (minX, minY, maxX - minX, maxY - minY);
+        const Rectangle<float> bounds (transformed.getBounds());
+        const float tolerance = 1.0e-4f * (1.0f + expectedBounds.getWidth() + expectedBounds.getHeight());
+        expect (std::abs (bounds.getX() - expectedBounds.getX()) <= tolerance
+                 && std::abs (bounds.getY() - expectedBounds.getY()) <= tolerance
+                 && std::abs (bounds.getRight() - expectedBounds.getRight()) <= tolerance
+                 && std::abs (bounds.getBottom() - expectedBounds.getBottom()) <= tolerance,
+                bounds.toString() + " != " + expectedBounds.toString());
+    }
+
+    static Path createRandomPolygon (Random& r, const int numPoints)
+    {
+        Path p;
+        p.startNewSubPath (r.nextFloat() * 500.0f, r.nextFloat() * 500.0f);
+
+        for (int i = 1; i < numPoints; ++i)
+            p.lineTo (r.nextFloat() * 500.0f, r.nextFloat() * 500.0f);
+
+        p.closeSubPath();
+        return p;
+    }
+
+    static Path createCurvyPath (Random& r)
+    {
+        Path p;
+        p.addEllipse (10.0f, 20.0f, 300.0f, 150.0f);
+        p.addStar (Point<float> (200.0f, 200.0f), 7, 40.0f, 120.0f, 0.3f);
+        p.startNewSubPath (50.0f, 400.0f);
+
+        for (int i = 0; i < 20; ++i)
+        {
+            p.quadraticTo (r.nextFloat() * 500.0f, r.nextFloat() * 500.0f, r.nextFloat() * 500.0f, r.nextFloat() * 500.0f);
+            p.cubicTo (r.nextFloat() * 500.0f, r.nextFloat() * 500.0f, r.nextFloat() * 500.0f, r.nextFloat() * 500.0f,
+                       r.nextFloat() * 500.0f, r.nextFloat() * 500.0f);
+        }
+
+        p.closeSubPath();
+        return p;
+    }
+
+    void runTest()
+    {
+        Random r (4321);
+
+        beginTest ("Cached queries on polygons");
+
+        for (int i = 0; i < 10; ++i)
+        {
+            Path p (createRandomPolygon (r, 3 + r.nextInt (300)));
+            checkQueries (p, r);
+
+            p.setUsingNonZeroWinding (false);
+            checkQueries (p, r);
+        }
+
+        beginTest ("Cached queries on curves");
+
+        for (int i = 0; i < 5; ++i)
+        {
+            Path p (createCurvyPath (r));
+            checkQueries (p, r);
+
+            p.setUsingNonZeroWinding (false);
+            checkQueries (p, r);
+        }
+
+        beginTest ("Transforming");
+
+        {
+            const Path p (createCurvyPath (r));
+            checkTransform (p, AffineTransform::translation (12.5f, -7.25f));
+            checkTransform (p, AffineTransform::scale (1.5f, 0.25f).translated (3.0f, 4.0f));
+            checkTransform (p, AffineTransform::scale (-2.0f, -0.5f).translated (-10.0f, 20.0f));
+            checkTransform (p, AffineTransform::rotation (0.7f).scaled (1.2f, 0.8f).translated (5.0f, -5.0f));
+            checkTransform (p, AffineTransform::shear (0.3f, -0.1f));
+        }
+
+        beginTest ("Cached queries after changing the path");
+
+        {
+            Path p (createRandomPolygon (r, 50));
+            checkQueries (p, r);
+
+            p.lineTo (600.0f, 600.0f);
+            p.quadraticTo (700.0f, 100.0f, 300.0f, -50.0f);
+            checkQueries (p, r);
+
+            p.addRectangle (-100.0f, -100.0f, 50.0f, 700.0f);
+            checkQueries (p, r);
+
+            p.applyTransform (AffineTransform::rotation (0.5f).scaled (1.5f, 0.7f));
+            checkQueries (p, r);
+
+            const Path copy (p);
+            p.clear();
+            p.addEllipse (0, 0, 100.0f, 100.0f);
+            checkQueries (p, r);
+            checkQueries (copy, r);
+        }
+    }
+};
+
+static PathTests pathTests;
+
+#endif
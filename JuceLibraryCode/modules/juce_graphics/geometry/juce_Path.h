@@ -66,6 +66,12 @@ class OutputStream;
     A path object can actually contain multiple sub-paths, which may themselves
     be open or closed.
 
+    The first time that contains(), intersectsLine(), getLength(), etc. are used, the
+    path keeps a flattened copy of itself, indexed so that later queries only need to
+    look at the lines near the point or line involved. This is thrown away whenever the
+    path is changed, so for hit-testing a shape repeatedly, it's best to keep the same
+    Path object rather than re-creating it each time.
+
     @see PathFlatteningIterator, PathStrokeType, Graphics
 */
 class JUCE_API  Path
@@ -754,12 +760,19 @@ private:
     PathBounds bounds;
     bool useNonZeroWinding;
 
+    struct FlattenedPath;
+    mutable Atomic<FlattenedPath*> flattenedPaths;
+    const FlattenedPath& getFlattenedPath (float tolerance, ScopedPointer<FlattenedPath>& uncachedPath) const;
+    void clearFlattenedPaths() noexcept;
+
     static const float lineMarker;
     static const float moveMarker;
     static const float quadMarker;
     static const float cubicMarker;
     static const float closeSubPathMarker;
 
+    static int getNumCoordinatesFor (float marker) noexcept;
+
     JUCE_LEAK_DETECTOR (Path);
 };
 
@@ -25,391 +25,546 @@
 
 #if (JUCE_MAC || JUCE_IOS) && USE_COREGRAPHICS_RENDERING && JUCE_USE_COREIMAGE_LOADER
  Image juce_loadWithCoreImage (InputStream& input);
-#else
+#endif
 
 //==============================================================================
 class GIFLoader
 {
 public:
     GIFLoader (InputStream& in)
-        : input (in),
-          dataBlockIsZero (false), fresh (false), finished (false),
-          currentBit (0), lastBit (0), lastByteIndex (0),
-          codeSize (0), setCodeSize (0), maxCode (0), maxCodeSize (0),
-          firstcode (0), oldcode (0), clearCode (0), endCode (0)
+        : screenWidth (0), screenHeight (0), numLoops (1),
+          input (in), numCompressedBytes (0)
+    {
+        zerostruct (globalPalette);
+        zerostruct (palette);
+    }
+
+    //==============================================================================
+    struct FrameInfo
     {
-        int imageWidth, imageHeight;
-        if (! getSizeFromHeader (imageWidth, imageHeight))
-            return;
+        FrameInfo() noexcept
+            : position (0), x (0), y (0), width (0), height (0),
+              transparentIndex (-1), disposal (0), delayMs (0), interlaced (false)
+        {}
+
+        int64 position;
+        int x, y, width, height;
+        int transparentIndex, disposal, delayMs;
+        bool interlaced;
+    };
+
+    //==============================================================================
+    bool readHeader()
+    {
+        char b[6];
+
+        if (input.read (b, 6) != 6
+             || ! (strncmp ("GIF87a", b, 6) == 0 || strncmp ("GIF89a", b, 6) == 0))
+            return false;
+
+        uint8 buf[7];
+        if (input.read (buf, 7) != 7)
+            return false;
 
-        uint8 buf [16];
-        if (in.read (buf, 3) != 3)
-            return;
+        screenWidth  = (int) ByteOrder::littleEndianShort (buf);
+        screenHeight = (int) ByteOrder::littleEndianShort (buf + 2);
 
-        int numColours = 2 << (buf[0] & 7);
-        int transparent = -1;
+        if ((buf[4] & 0x80) != 0 && ! readPalette (globalPalette, 2 << (buf[4] & 7)))
+            return false;
 
-        if ((buf[0] & 0x80) != 0)
-            readPalette (numColours);
+        return screenWidth > 0 && screenHeight > 0;
+    }
+
+    /** Skips forward to the next image in the file, collecting the settings from any
+        extension blocks on the way, and reads its header, leaving the stream ready for
+        decodeFrame() or skipFrame().
+    */
+    bool findNextFrame (FrameInfo& frame)
+    {
+        frame = FrameInfo();
 
         for (;;)
         {
-            if (input.read (buf, 1) != 1 || buf[0] == ';')
-                break;
+            uint8 type;
+            if (input.read (&type, 1) != 1 || type == ';')
+                return false;
 
-            if (buf[0] == '!')
+            if (type == '!')
             {
-                if (readExtension (transparent))
-                    continue;
-
-                break;
+                if (! readExtension (frame))
+                    return false;
             }
-
-            if (buf[0] != ',')
-                continue;
-
-            if (input.read (buf, 9) == 9)
+            else if (type == ',')
             {
-                imageWidth  = (int) ByteOrder::littleEndianShort (buf + 4);
-                imageHeight = (int) ByteOrder::littleEndianShort (buf + 6);
+                frame.position = input.getPosition();
+                return readFrameHeader (frame);
+            }
+        }
+    }
 
-                numColours = 2 << (buf[8] & 7);
+    /** Reads the image descriptor that starts at the stream's current position. */
+    bool readFrameHeader (FrameInfo& frame)
+    {
+        uint8 buf[9];
+        if (input.read (buf, 9) != 9)
+            return false;
 
-                if ((buf[8] & 0x80) != 0)
-                    if (! readPalette (numColours))
-                        break;
+        frame.x      = (int) ByteOrder::littleEndianShort (buf);
+        frame.y      = (int) ByteOrder::littleEndianShort (buf + 2);
+        frame.width  = (int) ByteOrder::littleEndianShort (buf + 4);
+        frame.height = (int) ByteOrder::littleEndianShort (buf + 6);
+        frame.interlaced = (buf[8] & 0x40) != 0;
 
-                image = Image (transparent >= 0 ? Image::ARGB : Image::RGB,
-                               imageWidth, imageHeight, transparent >= 0);
+        for (int i = 0; i < numElementsInArray (palette); ++i)
+            palette [i] = globalPalette [i];
 
-                image.getProperties()->set ("originalImageHadAlpha", transparent >= 0);
+        if ((buf[8] & 0x80) != 0 && ! readPalette (palette, 2 << (buf[8] & 7)))
+            return false;
 
-                readImage ((buf[8] & 0x40) != 0, transparent);
-            }
+        if (frame.transparentIndex >= 0)
+            palette [frame.transparentIndex].setARGB (0, 0, 0, 0);
 
-            break;
-        }
+        return frame.width > 0 && frame.height > 0;
     }
 
-    Image image;
-
-private:
-    InputStream& input;
-    uint8 buffer [260];
-    PixelARGB palette [256];
-    bool dataBlockIsZero, fresh, finished;
-    int currentBit, lastBit, lastByteIndex;
-    int codeSize, setCodeSize;
-    int maxCode, maxCodeSize;
-    int firstcode, oldcode;
-    int clearCode, endCode;
-    enum { maxGifCode = 1 << 12 };
-    int table [2] [maxGifCode];
-    int stack [2 * maxGifCode];
-    int* sp;
+    bool skipFrame()
+    {
+        uint8 minCodeSize;
+        return input.read (&minCodeSize, 1) == 1 && skipDataBlocks();
+    }
 
-    bool getSizeFromHeader (int& w, int& h)
+    /** Decompresses the current frame into the given bitmap, with its top-left at (destX, destY).
+        Pixels that fall outside the bitmap are dropped, and transparent pixels are left untouched
+        in ARGB bitmaps.
+    */
+    bool decodeFrame (const FrameInfo& frame, const Image::BitmapData& dest, const int destX, const int destY)
     {
-        char b[6];
+        uint8 minCodeSize;
+        if (input.read (&minCodeSize, 1) != 1 || minCodeSize < 1 || minCodeSize > 11)
+            return false;
+
+        // Pull in all the data sub-blocks in one go, so the decoder can run over a flat buffer..
+        readDataBlocks();
+
+        FrameWriter writer (frame, palette, dest, destX, destY);
 
-        if (input.read (b, 6) == 6
-             && (strncmp ("GIF87a", b, 6) == 0
-                  || strncmp ("GIF89a", b, 6) == 0))
+        const int clearCode = 1 << minCodeSize;
+        const int endCode = clearCode + 1;
+        int codeSize = minCodeSize + 1;
+        int nextCode = endCode + 1;
+        int previous = -1;
+
+        for (int i = 0; i < clearCode; ++i)
         {
-            if (input.read (b, 4) == 4)
-            {
-                w = (int) ByteOrder::littleEndianShort (b);
-                h = (int) ByteOrder::littleEndianShort (b + 2);
-                return w > 0 && h > 0;
-            }
+            prefix[i] = 0;
+            suffix[i] = firstChar[i] = (uint8) i;
+            lengths[i] = 1;
         }
 
-        return false;
-    }
+        const uint8* data = static_cast <const uint8*> (compressedData.getData());
+        const uint8* const dataEnd = data + numCompressedBytes;
+        uint32 bitBuffer = 0;
+        int numBits = 0;
 
-    bool readPalette (const int numCols)
-    {
-        for (int i = 0; i < numCols; ++i)
+        while (! writer.isFinished())
         {
-            uint8 rgb[4];
-            input.read (rgb, 3);
+            while (numBits < codeSize && data < dataEnd)
+            {
+                bitBuffer |= ((uint32) *data++) << numBits;
+                numBits += 8;
+            }
 
-            palette[i].setARGB (0xff, rgb[0], rgb[1], rgb[2]);
-            palette[i].premultiply();
-        }
+            if (numBits < codeSize)
+                break;
 
-        return true;
-    }
+            const int code = (int) (bitBuffer & ((1u << codeSize) - 1));
+            bitBuffer >>= codeSize;
+            numBits -= codeSize;
 
-    int readDataBlock (uint8* const dest)
-    {
-        uint8 n;
-        if (input.read (&n, 1) == 1)
-        {
-            dataBlockIsZero = (n == 0);
+            if (code == clearCode)
+            {
+                codeSize = minCodeSize + 1;
+                nextCode = endCode + 1;
+                previous = -1;
+                continue;
+            }
 
-            if (dataBlockIsZero || (input.read (dest, n) == n))
-                return n;
-        }
+            if (code == endCode)
+                break;
 
-        return -1;
-    }
+            if (previous < 0)
+            {
+                if (code > clearCode)
+                    break;
 
-    int readExtension (int& transparent)
-    {
-        uint8 type;
-        if (input.read (&type, 1) != 1)
-            return false;
+                writer.write (firstChar + code, 1);
+                previous = code;
+                continue;
+            }
 
-        uint8 b [260];
-        int n = 0;
+            if (code > nextCode || (code == nextCode && nextCode >= maxGifCode))
+                break; // corrupt data
 
-        if (type == 0xf9)
-        {
-            n = readDataBlock (b);
-            if (n < 0)
-                return 1;
+            if (nextCode < maxGifCode)
+            {
+                prefix [nextCode]    = (uint16) previous;
+                suffix [nextCode]    = firstChar [code == nextCode ? previous : code];
+                firstChar [nextCode] = firstChar [previous];
+                lengths [nextCode]   = (uint16) (lengths [previous] + 1);
 
-            if ((b[0] & 1) != 0)
-                transparent = b[3];
-        }
+                if (++nextCode == (1 << codeSize) && codeSize < 12)
+                    ++codeSize;
+            }
 
-        do
-        {
-            n = readDataBlock (b);
+            writeString (writer, code, clearCode);
+            previous = code;
         }
-        while (n > 0);
 
-        return n >= 0;
+        return true;
     }
 
-    void clearTable()
+    int screenWidth, screenHeight, numLoops;
+
+private:
+    //==============================================================================
+    /** Collects the decoded palette indexes for each line, and converts them to
+        pixels when a line is complete.
+    */
+    class FrameWriter
     {
-        int i;
-        for (i = 0; i < clearCode; ++i)
+    public:
+        FrameWriter (const FrameInfo& frame, const PixelARGB* const palette_,
+                     const Image::BitmapData& dest_, const int destX_, const int destY_)
+            : palette (palette_), dest (dest_),
+              width (frame.width), height (frame.height), destX (destX_), destY (destY_),
+              transparentIndex (frame.transparentIndex),
+              x (0), y (0), yStep (frame.interlaced ? 8 : 1), pass (frame.interlaced ? 0 : 3),
+              finished (false)
         {
-            table[0][i] = 0;
-            table[1][i] = i;
+            lineIndexes.malloc ((size_t) width);
         }
 
-        for (; i < maxGifCode; ++i)
+        bool isFinished() const noexcept   { return finished; }
+
+        /** Returns somewhere to write a run of pixels if it fits on the current line. */
+        uint8* getSpaceOnLine (const int num) noexcept
         {
-            table[0][i] = 0;
-            table[1][i] = 0;
+            return x + num <= width ? lineIndexes + x : nullptr;
         }
-    }
 
-    void initialise (const int inputCodeSize)
-    {
-        setCodeSize = inputCodeSize;
-        codeSize = setCodeSize + 1;
-        clearCode = 1 << setCodeSize;
-        endCode = clearCode + 1;
-        maxCodeSize = 2 * clearCode;
-        maxCode = clearCode + 2;
-
-        getCode (0, true);
-
-        fresh = true;
-        clearTable();
-        sp = stack;
-    }
-
-    int readLZWByte()
-    {
-        if (fresh)
+        void advance (const int num)
         {
-            fresh = false;
+            if ((x += num) == width)
+                finishLine();
+        }
 
-            for (;;)
+        void write (const uint8* src, int num)
+        {
+            while (num > 0 && ! finished)
             {
-                firstcode = oldcode = getCode (codeSize, false);
-
-                if (firstcode != clearCode)
-                    return firstcode;
+                const int numThisLine = jmin (num, width - x);
+                memcpy (lineIndexes + x, src, (size_t) numThisLine);
+                src += numThisLine;
+                num -= numThisLine;
+                advance (numThisLine);
             }
         }
 
-        if (sp > stack)
-            return *--sp;
-
-        int code;
+    private:
+        const PixelARGB* const palette;
+        const Image::BitmapData& dest;
+        HeapBlock<uint8> lineIndexes;
+        const int width, height, destX, destY, transparentIndex;
+        int x, y, yStep, pass;
+        bool finished;
 
-        while ((code = getCode (codeSize, false)) >= 0)
+        void finishLine()
         {
-            if (code == clearCode)
-            {
-                clearTable();
-                codeSize = setCodeSize + 1;
-                maxCodeSize = 2 * clearCode;
-                maxCode = clearCode + 2;
-                sp = stack;
-                firstcode = oldcode = getCode (codeSize, false);
-                return firstcode;
-            }
-            else if (code == endCode)
+            x = 0;
+            const int lineY = destY + y;
+
+            if (lineY >= 0 && lineY < dest.height)
             {
-                if (dataBlockIsZero)
-                    return -2;
+                const int startX = jmax (0, -destX);
+                const int endX = jmin (width, dest.width - destX);
 
-                uint8 buf [260];
-                int n;
+                if (startX < endX)
+                {
+                    uint8* p = dest.getPixelPointer (destX + startX, lineY);
 
-                while ((n = readDataBlock (buf)) > 0)
-                {}
+                    if (dest.pixelFormat == Image::ARGB)
+                    {
+                        for (int i = startX; i < endX; ++i)
+                        {
+                            const int index = lineIndexes[i];
 
-                if (n != 0)
-                    return -2;
+                            if (index != transparentIndex)
+                                ((PixelARGB*) p)->set (palette [index]);
+
+                            p += dest.pixelStride;
+                        }
+                    }
+                    else
+                    {
+                        for (int i = startX; i < endX; ++i)
+                        {
+                            ((PixelRGB*) p)->set (palette [lineIndexes[i]]);
+                            p += dest.pixelStride;
+                        }
+                    }
+                }
             }
 
-            const int incode = code;
+            y += yStep;
 
-            if (code >= maxCode)
+            while (y >= height)
             {
-                *sp++ = firstcode;
-                code = oldcode;
+                switch (++pass)
+                {
+                    case 1:     y = 4; yStep = 8; break;
+                    case 2:     y = 2; yStep = 4; break;
+                    case 3:     y = 1; yStep = 2; break;
+                    default:    finished = true; return;
+                }
             }
+        }
 
-            while (code >= clearCode)
-            {
-                *sp++ = table[1][code];
-                if (code == table[0][code])
-                    return -2;
+        JUCE_DECLARE_NON_COPYABLE (FrameWriter);
+    };
 
-                code = table[0][code];
-            }
+    //==============================================================================
+    InputStream& input;
+    PixelARGB globalPalette [256], palette [256];
+    MemoryBlock compressedData;
+    size_t numCompressedBytes;
 
-            *sp++ = firstcode = table[1][code];
+    enum { maxGifCode = 1 << 12 };
+    uint16 prefix [maxGifCode], lengths [maxGifCode];
+    uint8 suffix [maxGifCode], firstChar [maxGifCode];
+    uint8 stack [maxGifCode];
 
-            if ((code = maxCode) < maxGifCode)
-            {
-                table[0][code] = oldcode;
-                table[1][code] = firstcode;
-                ++maxCode;
+    void writeString (FrameWriter& writer, int code, const int clearCode)
+    {
+        // The table stores each string back-to-front, so write it backwards, straight into
+        // the current line if it fits there..
+        const int length = lengths [code];
+        uint8* const lineSpace = writer.getSpaceOnLine (length);
+        uint8* const start = lineSpace != nullptr ? lineSpace : stack;
+        uint8* p = start + length;
+
+        while (code >= clearCode)
+        {
+            *--p = suffix [code];
+            code = prefix [code];
+        }
 
-                if (maxCode >= maxCodeSize && maxCodeSize < maxGifCode)
-                {
-                    maxCodeSize <<= 1;
-                    ++codeSize;
-                }
-            }
+        *--p = (uint8) code;
 
-            oldcode = incode;
+        if (lineSpace != nullptr)
+            writer.advance (length);
+        else
+            writer.write (stack, length);
+    }
+
+    bool readPalette (PixelARGB* const dest, const int numCols)
+    {
+        uint8 rgb [3 * 256];
+        if (input.read (rgb, 3 * numCols) != 3 * numCols)
+            return false;
 
-            if (sp > stack)
-                return *--sp;
+        for (int i = 0; i < numCols; ++i)
+        {
+            dest[i].setARGB (0xff, rgb [i * 3], rgb [i * 3 + 1], rgb [i * 3 + 2]);
+            dest[i].premultiply();
         }
 
-        return code;
+        return true;
     }
 
-    int getCode (const int codeSize_, const bool shouldInitialise)
+    int readDataBlock (uint8* const dest)
     {
-        if (shouldInitialise)
+        uint8 n;
+        if (input.read (&n, 1) == 1)
         {
-            currentBit = 0;
-            lastBit = 0;
-            finished = false;
-            return 0;
+            if (n == 0 || (input.read (dest, n) == n))
+                return n;
         }
 
-        if ((currentBit + codeSize_) >= lastBit)
+        return -1;
+    }
+
+    void readDataBlocks()
+    {
+        numCompressedBytes = 0;
+
+        for (;;)
         {
-            if (finished)
-                return -1;
+            uint8 n;
+            if (input.read (&n, 1) != 1 || n == 0)
+                break;
 
-            buffer[0] = buffer [lastByteIndex - 2];
-            buffer[1] = buffer [lastByteIndex - 1];
+            if (numCompressedBytes + n > compressedData.getSize())
+                compressedData.setSize (jmax ((size_t) 4096, (numCompressedBytes + n) * 2));
 
-            const int n = readDataBlock (buffer + 2);
+            const int numRead = input.read (static_cast <uint8*> (compressedData.getData()) + numCompressedBytes, n);
+            numCompressedBytes += (size_t) jmax (0, numRead);
+
+            if (numRead != n)
+                break;
+        }
+    }
+
+    bool skipDataBlocks()
+    {
+        for (;;)
+        {
+            uint8 n;
+            if (input.read (&n, 1) != 1)
+                return false;
 
             if (n == 0)
-                finished = true;
+                return true;
 
-            lastByteIndex = 2 + n;
-            currentBit = (currentBit - lastBit) + 16;
-            lastBit = (2 + n) * 8 ;
+            input.skipNextBytes (n);
         }
+    }
 
-        int result = 0;
-        int i = currentBit;
+    bool readExtension (FrameInfo& frame)
+    {
+        uint8 type;
+        if (input.read (&type, 1) != 1)
+            return false;
 
-        for (int j = 0; j < codeSize_; ++j)
+        uint8 b [260];
+        int n = readDataBlock (b);
+
+        if (n < 0)
+            return false;
+
+        if (type == 0xf9 && n >= 4)
         {
-            result |= ((buffer[i >> 3] & (1 << (i & 7))) != 0) << j;
-            ++i;
+            frame.disposal = (b[0] >> 2) & 7;
+            frame.delayMs = 10 * (int) ByteOrder::littleEndianShort (b + 1);
+
+            if ((b[0] & 1) != 0)
+                frame.transparentIndex = b[3];
+        }
+        else if (type == 0xff && n == 11 && memcmp (b, "NETSCAPE2.0", 11) == 0)
+        {
+            n = readDataBlock (b);
+
+            if (n >= 3 && b[0] == 1)
+                numLoops = (int) ByteOrder::littleEndianShort (b + 1);
         }
 
-        currentBit += codeSize_;
-        return result;
+        return n == 0 || skipDataBlocks();
     }
 
-    bool readImage (const int interlace, const int transparent)
+    JUCE_DECLARE_NON_COPYABLE (GIFLoader);
+};
+
+//==============================================================================
+class GIFImageFormat::Animation::Pimpl
+{
+public:
+    Pimpl (InputStream& in)
+        : nextFrame (0)
     {
-        uint8 c;
-        if (input.read (&c, 1) != 1)
-            return false;
+        in.readIntoMemoryBlock (data);
+        stream = new MemoryInputStream (data, false);
+        loader = new GIFLoader (*stream);
 
-        initialise (c);
+        if (loader->readHeader())
+        {
+            GIFLoader::FrameInfo frame;
 
-        if (transparent >= 0)
-            palette [transparent].setARGB (0, 0, 0, 0);
+            while (loader->findNextFrame (frame))
+            {
+                frames.add (frame);
 
-        int xpos = 0, ypos = 0, yStep = 8, pass = 0;
+                if (! loader->skipFrame())
+                    break;
+            }
+        }
+    }
 
-        const Image::BitmapData destData (image, Image::BitmapData::writeOnly);
-        uint8* p = destData.getPixelPointer (0, 0);
-        const bool hasAlpha = image.hasAlphaChannel();
+    Image getFrame (const int index)
+    {
+        if (! isPositiveAndBelow (index, frames.size()))
+            return Image::null;
 
-        for (;;)
+        if (index < nextFrame || canvas.isNull())
         {
-            const int index = readLZWByte();
-            if (index < 0)
-                break;
+            canvas = Image (Image::ARGB, loader->screenWidth, loader->screenHeight, true);
+            previousCanvas = Image::null;
+            nextFrame = 0;
+        }
 
-            if (hasAlpha)
-                ((PixelARGB*) p)->set (palette [index]);
-            else
-                ((PixelRGB*)  p)->set (palette [index]);
+        while (nextFrame <= index)
+            renderNextFrame();
 
-            p += destData.pixelStride;
+        return canvas.createCopy();
+    }
 
-            if (++xpos == destData.width)
-            {
-                xpos = 0;
+    MemoryBlock data;
+    ScopedPointer<MemoryInputStream> stream;
+    ScopedPointer<GIFLoader> loader;
+    Array<GIFLoader::FrameInfo> frames;
 
-                if (interlace)
-                {
-                    ypos += yStep;
+private:
+    Image canvas, previousCanvas;
+    int nextFrame;
 
-                    while (ypos >= destData.height)
-                    {
-                        switch (++pass)
-                        {
-                            case 1:     ypos = 4; yStep = 8; break;
-                            case 2:     ypos = 2; yStep = 4; break;
-                            case 3:     ypos = 1; yStep = 2; break;
-                            default:    return true;
-                        }
-                    }
-                }
-                else
-                {
-                    if (++ypos >= destData.height)
-                        break;
-                }
+    void renderNextFrame()
+    {
+        if (nextFrame > 0)
+        {
+            // Apply the disposal method of the frame that's currently showing..
+            const GIFLoader::FrameInfo& last = frames.getReference (nextFrame - 1);
 
-                p = destData.getPixelPointer (xpos, ypos);
+            if (last.disposal == 2)
+            {
+                canvas.clear (Rectangle<int> (last.x, last.y, last.width, last.height));
+            }
+            else if (last.disposal == 3 && previousCanvas.isValid())
+            {
+                canvas = previousCanvas;
+                previousCanvas = Image::null;
             }
         }
 
-        return true;
+        GIFLoader::FrameInfo frame (frames.getReference (nextFrame++));
+
+        if (frame.disposal == 3)
+            previousCanvas = canvas.createCopy();
+
+        if (stream->setPosition (frame.position) && loader->readFrameHeader (frame))
+        {
+            const Image::BitmapData destData (canvas, Image::BitmapData::readWrite);
+            loader->decodeFrame (frame, destData, frame.x, frame.y);
+        }
     }
 
-    JUCE_DECLARE_NON_COPYABLE (GIFLoader);
+    JUCE_DECLARE_NON_COPYABLE (Pimpl);
 };
 
-#endif
+GIFImageFormat::Animation::Animation (InputStream& input)   : pimpl (new Pimpl (input)) {}
+GIFImageFormat::Animation::~Animation() {}
+
+int GIFImageFormat::Animation::getWidth() const noexcept        { return pimpl->loader->screenWidth; }
+int GIFImageFormat::Animation::getHeight() const noexcept       { return pimpl->loader->screenHeight; }
+int GIFImageFormat::Animation::getNumFrames() const noexcept    { return pimpl->frames.size(); }
+int GIFImageFormat::Animation::getNumLoops() const noexcept     { return pimpl->loader->numLoops; }
+
+int GIFImageFormat::Animation::getFrameDelay (const int frameIndex) const noexcept
+{
+    return isPositiveAndBelow (frameIndex, pimpl->frames.size()) ? pimpl->frames.getReference (frameIndex).delayMs : 0;
+}
+
+Image GIFImageFormat::Animation::getFrame (const int frameIndex)
+{
+    return pimpl->getFrame (frameIndex);
+}
 
 //==============================================================================
 GIFImageFormat::GIFImageFormat() {}
@@ -433,7 +588,18 @@ Image GIFImageFormat::decodeImage (InputStream& in)
     return juce_loadWithCoreImage (in);
    #else
     const ScopedPointer <GIFLoader> loader (new GIFLoader (in));
-    return loader->image;
+    GIFLoader::FrameInfo frame;
+
+    if (! (loader->readHeader() && loader->findNextFrame (frame)))
+        return Image::null;
+
+    const bool hasAlpha = frame.transparentIndex >= 0;
+    Image image (hasAlpha ? Image::ARGB : Image::RGB, frame.width, frame.height, hasAlpha);
+    image.getProperties()->set ("originalImageHadAlpha", hasAlpha);
+
+    const Image::BitmapData destData (image, Image::BitmapData::writeOnly);
+    loader->decodeFrame (frame, destData, 0, 0);
+    return image;
    #endif
 }
 
@@ -253,6 +253,706 @@ Image Image::createCopy() const
     return Image (image != nullptr ? image->clone() : nullptr);
 }
 
+//==============================================================================
+/*  Whole-image operations are done a row at a time. Large images are split into bands
+    of rows which are shared between a pool of threads, and the inner loops for the
+    common cases have SSE2 versions, which are used if the CPU supports them.
+*/
+namespace ImagePixelOps
+{
+   #if JUCE_USE_SSE2_PIXEL_OPS
+    static bool canUseSSE2() noexcept
+    {
+       #if JUCE_64BIT
+        return true;    // all x86-64 CPUs have SSE2
+       #else
+        static const bool hasSSE2 = SystemStats::hasSSE2();
+        return hasSSE2;
+       #endif
+    }
+   #endif
+
+    static void multiplyAlpha (PixelARGB* pixels, int num, const int multiplier) noexcept
+    {
+       #if JUCE_USE_SSE2_PIXEL_OPS
+        if (canUseSSE2() && isPositiveAndNotGreaterThan (multiplier, 255))
+        {
+            const __m128i m (_mm_set1_epi16 ((short) (multiplier + 1)));
+            const __m128i zero (_mm_setzero_si128());
+
+            for (; num >= 4; num -= 4, pixels += 4)
+            {
+                const __m128i p (_mm_loadu_si128 ((const __m128i*) pixels));
+                const __m128i lo (_mm_srli_epi16 (_mm_mullo_epi16 (_mm_unpacklo_epi8 (p, zero), m), 8));
+                const __m128i hi (_mm_srli_epi16 (_mm_mullo_epi16 (_mm_unpackhi_epi8 (p, zero), m), 8));
+                _mm_storeu_si128 ((__m128i*) pixels, _mm_packus_epi16 (lo, hi));
+            }
+        }
+       #endif
+
+        while (--num >= 0)
+            (pixels++)->multiplyAlpha (multiplier);
+    }
+
+    static void copyAlphaChannel (const PixelARGB* src, uint8* dest, int num) noexcept
+    {
+       #if JUCE_USE_SSE2_PIXEL_OPS
+        if (canUseSSE2())
+        {
+            for (; num >= 16; num -= 16, src += 16, dest += 16)
+            {
+                // (this goes via a byte pointer, as casting a pointer to the packed PixelARGB
+                // type straight to an __m128i* triggers -Waddress-of-packed-member)
+                const uint8* const s = (const uint8*) src;
+                const __m128i a0 (_mm_srli_epi32 (_mm_loadu_si128 ((const __m128i*) s), 24));
+                const __m128i a1 (_mm_srli_epi32 (_mm_loadu_si128 ((const __m128i*) (s + 16)), 24));
+                const __m128i a2 (_mm_srli_epi32 (_mm_loadu_si128 ((const __m128i*) (s + 32)), 24));
+                const __m128i a3 (_mm_srli_epi32 (_mm_loadu_si128 ((const __m128i*) (s + 48)), 24));
+
+                _mm_storeu_si128 ((__m128i*) dest, _mm_packus_epi16 (_mm_packs_epi32 (a0, a1),
+                                                                     _mm_packs_epi32 (a2, a3)));
+            }
+        }
+       #endif
+
+        while (--num >= 0)
+            *dest++ = (src++)->getAlpha();
+    }
+
+    static void expandAlphaChannel (const uint8* src, PixelARGB* dest, int num) noexcept
+    {
+       #if JUCE_USE_SSE2_PIXEL_OPS
+        if (canUseSSE2())
+        {
+            for (; num >= 16; num -= 16, src += 16, dest += 16)
+            {
+                const __m128i a (_mm_loadu_si128 ((const __m128i*) src));
+                const __m128i lo (_mm_unpacklo_epi8 (a, a));
+                const __m128i hi (_mm_unpackhi_epi8 (a, a));
+                uint8* const d = (uint8*) dest; // (see copyAlphaChannel)
+
+                _mm_storeu_si128 ((__m128i*) d,        _mm_unpacklo_epi16 (lo, lo));
+                _mm_storeu_si128 ((__m128i*) (d + 16), _mm_unpackhi_epi16 (lo, lo));
+                _mm_storeu_si128 ((__m128i*) (d + 32), _mm_unpacklo_epi16 (hi, hi));
+                _mm_storeu_si128 ((__m128i*) (d + 48), _mm_unpackhi_epi16 (hi, hi));
+            }
+        }
+       #endif
+
+        while (--num >= 0)
+            (dest++)->set (*(const PixelAlpha*) src++);
+    }
+
+    static void fill (PixelARGB* dest, int num, const PixelARGB& colour) noexcept
+    {
+       #if JUCE_USE_SSE2_PIXEL_OPS
+        if (canUseSSE2())
+        {
+            const __m128i c (_mm_set1_epi32 ((int) colour.getARGB()));
+
+            for (; num >= 4; num -= 4, dest += 4)
+                _mm_storeu_si128 ((__m128i*) dest, c);
+        }
+       #endif
+
+        while (--num >= 0)
+            (dest++)->set (colour);
+    }
+
+    //==============================================================================
+    class BandThreadPool  : public DeletedAtShutdown
+    {
+    public:
+        BandThreadPool()  : pool (jmax (1, SystemStats::getNumCpus() - 1)) {}
+        ~BandThreadPool()  { clearSingletonInstance(); }
+
+        juce_DeclareSingleton (BandThreadPool, false);
+
+        ThreadPool pool;
+
+    private:
+        JUCE_DECLARE_NON_COPYABLE (BandThreadPool);
+    };
+
+    juce_ImplementSingleton (BandThreadPool);
+
+    template <class RowOperation>
+    class BandJob  : public ThreadPoolJob
+    {
+    public:
+        BandJob (const RowOperation& op_, const int startRow_, const int endRow_)
+            : ThreadPoolJob ("Image pixel operation"),
+              op (op_), startRow (startRow_), endRow (endRow_)
+        {}
+
+        JobStatus runJob()
+        {
+            for (int y = startRow; y < endRow; ++y)
+                op (y);
+
+            return jobHasFinished;
+        }
+
+    private:
+        const RowOperation& op;
+        const int startRow, endRow;
+
+        JUCE_DECLARE_NON_COPYABLE (BandJob);
+    };
+
+    enum
+    {
+        minPixelsForThreading = 256 * 1024,
+        minRowsPerBand = 16
+    };
+
+    /* Calls op (y) for each row from 0 to height - 1. The rows of big images are split
+       into bands, one of which is done on the calling thread while the pool does the others.
+       Callers whose "rows" are really bigger units of work can lower the number of them
+       that a band needs, as long as width is the number of pixels in each of them.
+    */
+    template <class RowOperation>
+    static void processRows (const int width, const int height, const RowOperation& op,
+                             const int minRowsInBand = minRowsPerBand)
+    {
+        const int numCpus = SystemStats::getNumCpus();
+        const int numBands = (numCpus > 1 && width * height >= (int) minPixelsForThreading)
+                                ? jmin (numCpus, height / minRowsInBand) : 1;
+
+        if (numBands <= 1)
+        {
+            for (int y = 0; y < height; ++y)
+                op (y);
+
+            return;
+        }
+
+        ThreadPool& pool = BandThreadPool::getInstance()->pool;
+        OwnedArray<BandJob<RowOperation> > jobs;
+
+        for (int i = 1; i < numBands; ++i)
+        {
+            BandJob<RowOperation>* const job = new BandJob<RowOperation> (op, (height * i) / numBands,
+                                                                          (height * (i + 1)) / numBands);
+            jobs.add (job);
+            pool.addJob (job, false);
+        }
+
+        for (int y = 0; y < height / numBands; ++y)
+            op (y);
+
+        for (int i = 0; i < jobs.size(); ++i)
+            pool.waitForJobToFinish (jobs.getUnchecked (i), -1);
+    }
+
+    //==============================================================================
+    struct CopyAlphaChannelOp
+    {
+        CopyAlphaChannelOp (const Image::BitmapData& srcData_, const Image::BitmapData& destData_) noexcept
+            : srcData (srcData_), destData (destData_) {}
+
+        void operator() (const int y) const noexcept
+        {
+            copyAlphaChannel ((const PixelARGB*) srcData.getLinePointer (y), destData.getLinePointer (y), srcData.width);
+        }
+
+        const Image::BitmapData& srcData;
+        const Image::BitmapData& destData;
+
+        JUCE_DECLARE_NON_COPYABLE (CopyAlphaChannelOp);
+    };
+
+    struct ExpandAlphaChannelOp
+    {
+        ExpandAlphaChannelOp (const Image::BitmapData& srcData_, const Image::BitmapData& destData_) noexcept
+            : srcData (srcData_), destData (destData_) {}
+
+        void operator() (const int y) const noexcept
+        {
+            expandAlphaChannel (srcData.getLinePointer (y), (PixelARGB*) destData.getLinePointer (y), srcData.width);
+        }
+
+        const Image::BitmapData& srcData;
+        const Image::BitmapData& destData;
+
+        JUCE_DECLARE_NON_COPYABLE (ExpandAlphaChannelOp);
+    };
+
+    template <class SrcPixelType, class DestPixelType>
+    struct ConvertPixelsOp
+    {
+        ConvertPixelsOp (const Image::BitmapData& srcData_, const Image::BitmapData& destData_) noexcept
+            : srcData (srcData_), destData (destData_) {}
+
+        void operator() (const int y) const noexcept
+        {
+            const uint8* src = srcData.getLinePointer (y);
+            uint8* dest = destData.getLinePointer (y);
+
+            for (int x = srcData.width; --x >= 0;)
+            {
+                ((DestPixelType*) dest)->set (*(const SrcPixelType*) src);
+                src += srcData.pixelStride;
+                dest += destData.pixelStride;
+            }
+        }
+
+        const Image::BitmapData& srcData;
+        const Image::BitmapData& destData;
+
+        JUCE_DECLARE_NON_COPYABLE (ConvertPixelsOp);
+    };
+
+    template <class SrcPixelType, class DestPixelType>
+    static void convertPixels (const Image::BitmapData& srcData, const Image::BitmapData& destData)
+    {
+        processRows (srcData.width, srcData.height, ConvertPixelsOp<SrcPixelType, DestPixelType> (srcData, destData));
+    }
+
+    //==============================================================================
+    template <class PixelType, class PixelOperation>
+    struct PerPixelRowOp
+    {
+        PerPixelRowOp (const Image::BitmapData& data_, const PixelOperation& pixelOp_) noexcept
+            : data (data_), pixelOp (pixelOp_) {}
+
+        void operator() (const int y) const
+        {
+            uint8* p = data.getLinePointer (y);
+
+            for (int x = 0; x < data.width; ++x)
+            {
+                pixelOp (*(PixelType*) p);
+                p += data.pixelStride;
+            }
+        }
+
+        const Image::BitmapData& data;
+        const PixelOperation& pixelOp;
+
+        JUCE_DECLARE_NON_COPYABLE (PerPixelRowOp);
+    };
+
+    template <class PixelType, class PixelOperation>
+    static void iterate (const Image::BitmapData& data, const PixelOperation& pixelOp)
+    {
+        processRows (data.width, data.height, PerPixelRowOp<PixelType, PixelOperation> (data, pixelOp));
+    }
+
+    template <class PixelOperation>
+    static void performPixelOp (const Image::BitmapData& data, const PixelOperation& pixelOp)
+    {
+        switch (data.pixelFormat)
+        {
+            case Image::ARGB:           iterate<PixelARGB>  (data, pixelOp); break;
+            case Image::RGB:            iterate<PixelRGB>   (data, pixelOp); break;
+            case Image::SingleChannel:  iterate<PixelAlpha> (data, pixelOp); break;
+            default:                    jassertfalse; break;
+        }
+    }
+
+    //==============================================================================
+    struct MultiplyAlphaOp
+    {
+        MultiplyAlphaOp (const Image::BitmapData& data_, const int multiplier_) noexcept
+            : data (data_), multiplier (multiplier_) {}
+
+        void operator() (const int y) const noexcept
+        {
+            multiplyAlpha ((PixelARGB*) data.getLinePointer (y), data.width, multiplier);
+        }
+
+        const Image::BitmapData& data;
+        const int multiplier;
+
+        JUCE_DECLARE_NON_COPYABLE (MultiplyAlphaOp);
+    };
+
+    struct FillARGBOp
+    {
+        FillARGBOp (const Image::BitmapData& data_, const PixelARGB& colour_) noexcept
+            : data (data_), colour (colour_) {}
+
+        void operator() (const int y) const noexcept
+        {
+            fill ((PixelARGB*) data.getLinePointer (y), data.width, colour);
+        }
+
+        const Image::BitmapData& data;
+        const PixelARGB colour;
+
+        JUCE_DECLARE_NON_COPYABLE (FillARGBOp);
+    };
+
+    struct FillSingleChannelOp
+    {
+        FillSingleChannelOp (const Image::BitmapData& data_, const uint8 level_) noexcept
+            : data (data_), level (level_) {}
+
+        void operator() (const int y) const noexcept
+        {
+            memset (data.getLinePointer (y), level, (size_t) data.width);
+        }
+
+        const Image::BitmapData& data;
+        const uint8 level;
+
+        JUCE_DECLARE_NON_COPYABLE (FillSingleChannelOp);
+    };
+
+    struct SetColourOp
+    {
+        SetColourOp (const PixelARGB& colour_) noexcept  : colour (colour_) {}
+
+        template <class PixelType>
+        void operator() (PixelType& pixel) const noexcept
+        {
+            pixel.set (colour);
+        }
+
+        const PixelARGB colour;
+
+        JUCE_DECLARE_NON_COPYABLE (SetColourOp);
+    };
+
+    static void fill (const Image::BitmapData& data, const PixelARGB& colour)
+    {
+        if (data.pixelFormat == Image::ARGB && data.pixelStride == (int) sizeof (PixelARGB))
+            processRows (data.width, data.height, FillARGBOp (data, colour));
+        else if (data.pixelFormat == Image::SingleChannel && data.pixelStride == 1)
+            processRows (data.width, data.height, FillSingleChannelOp (data, colour.getAlpha()));
+        else
+            performPixelOp (data, SetColourOp (colour));
+    }
+}
+
+//==============================================================================
+/*  A separable resampler for Image::rescaled(). Each axis gets a table of source
+    pixel weights for every destination pixel. The horizontal pass writes floats into
+    an intermediate buffer, and the vertical pass turns them back into pixels.
+*/
+namespace ImageResampling
+{
+    enum FilterType
+    {
+        boxFilter,      // exact area-averaging, for shrinking
+        tentFilter,     // linear interpolation
+        mitchellFilter  // Mitchell-Netravali cubic, B = C = 1/3
+    };
+
+    static double mitchell (double x) noexcept
+    {
+        x = std::abs (x);
+
+        if (x < 1.0)   return (7.0 * x * x * x - 12.0 * x * x + 16.0 / 3.0) / 6.0;
+        if (x < 2.0)   return (-7.0 / 3.0 * x * x * x + 12.0 * x * x - 20.0 * x + 32.0 / 3.0) / 6.0;
+
+        return 0;
+    }
+
+    class Weights
+    {
+    public:
+        Weights (const int srcSize, const int destSize, const FilterType type)
+        {
+            const double scale = srcSize / (double) destSize;
+            const double filterScale = jmax (1.0, scale);
+            const double support = type == boxFilter ? 0.5 * scale
+                                                     : (type == tentFilter ? 1.0 : 2.0) * filterScale;
+
+            maxTaps = (int) std::ceil (support * 2.0) + 2;
+            firstIndexes.malloc ((size_t) destSize);
+            numTaps.malloc ((size_t) destSize);
+            weights.calloc ((size_t) (destSize * maxTaps));
+
+            for (int i = 0; i < destSize; ++i)
+            {
+                float* const w = weights + i * maxTaps;
+                int first, last;
+
+                if (type == boxFilter)
+                {
+                    const double start = i * scale, end = start + scale;
+                    first = (int) start;
+                    last = jmin (srcSize - 1, (int) std::ceil (end) - 1);
+
+                    for (int j = first; j <= last; ++j)
+                        w[j - first] = (float) ((jmin (end, j + 1.0) - jmax (start, (double) j)) / scale);
+                }
+                else
+                {
+                    const double centre = (i + 0.5) * scale - 0.5;
+                    const int rawFirst = (int) std::ceil (centre - support);
+                    const int rawLast  = (int) std::floor (centre + support);
+                    first = jlimit (0, srcSize - 1, rawFirst);
+                    last  = jlimit (0, srcSize - 1, rawLast);
+                    double total = 0;
+
+                    for (int j = rawFirst; j <= rawLast; ++j)
+                    {
+                        const double x = (j - centre) / filterScale;
+                        const double v = type == tentFilter ? jmax (0.0, 1.0 - std::abs (x)) : mitchell (x);
+
+                        // taps that fall off the edge of the image are given to the edge pixel
+                        w [jlimit (first, last, j) - first] += (float) v;
+                        total += v;
+                    }
+
+                    if (total != 0)
+                        for (int j = first; j <= last; ++j)
+                            w[j - first] = (float) (w[j - first] / total);
+                }
+
+                firstIndexes[i] = first;
+                numTaps[i] = last - first + 1;
+            }
+        }
+
+        int getFirstIndex (const int i) const noexcept          { return firstIndexes[i]; }
+        int getNumTaps (const int i) const noexcept             { return numTaps[i]; }
+        const float* getWeights (const int i) const noexcept    { return weights + i * maxTaps; }
+        int getMaxTaps() const noexcept                         { return maxTaps; }
+
+    private:
+        HeapBlock<int> firstIndexes, numTaps;
+        HeapBlock<float> weights;
+        int maxTaps;
+
+        JUCE_DECLARE_NON_COPYABLE (Weights);
+    };
+
+    //==============================================================================
+    static void resampleRow (const uint8* const src, float* d, const int destWidth,
+                             const int numChannels, const Weights& weights) noexcept
+    {
+        for (int x = 0; x < destWidth; ++x)
+        {
+            const uint8* s = src + weights.getFirstIndex (x) * numChannels;
+            const float* const w = weights.getWeights (x);
+            const int numTaps = weights.getNumTaps (x);
+
+           #if JUCE_USE_SSE2_PIXEL_OPS
+            if (numChannels == 4 && ImagePixelOps::canUseSSE2())
+            {
+                const __m128i zero (_mm_setzero_si128());
+                __m128 total (_mm_setzero_ps());
+
+                for (int i = 0; i < numTaps; ++i, s += 4)
+                {
+                    const __m128i p (_mm_cvtsi32_si128 (*(const int*) s));
+                    const __m128 channels (_mm_cvtepi32_ps (_mm_unpacklo_epi16 (_mm_unpacklo_epi8 (p, zero), zero)));
+                    total = _mm_add_ps (total, _mm_mul_ps (channels, _mm_set1_ps (w[i])));
+                }
+
+                _mm_storeu_ps (d, total);
+                d += 4;
+                continue;
+            }
+           #endif
+
+            for (int c = 0; c < numChannels; ++c)
+            {
+                float total = 0;
+
+                for (int i = 0; i < numTaps; ++i)
+                    total += w[i] * s [i * numChannels + c];
+
+                *d++ = total;
+            }
+        }
+    }
+
+    static void addWeightedRow (float* const totals, const float* const row, const float weight, const int num) noexcept
+    {
+        int i = 0;
+
+       #if JUCE_USE_SSE2_PIXEL_OPS
+        if (ImagePixelOps::canUseSSE2())
+        {
+            const __m128 w (_mm_set1_ps (weight));
+
+            for (; i < num - 3; i += 4)
+                _mm_storeu_ps (totals + i, _mm_add_ps (_mm_loadu_ps (totals + i),
+                                                       _mm_mul_ps (_mm_loadu_ps (row + i), w)));
+        }
+       #endif
+
+        for (; i < num; ++i)
+            totals[i] += row[i] * weight;
+    }
+
+    /*  Produces a chunk of destination rows. The horizontally-resampled source rows that
+        the vertical filter needs are kept in a small ring, so each one is only made once
+        per chunk and the intermediate data stays in the cache.
+    */
+    struct ResampleChunkOp
+    {
+        ResampleChunkOp (const Image::BitmapData& srcData_, const Image::BitmapData& destData_,
+                         const Weights& xWeights_, const Weights& yWeights_,
+                         const int rowsPerChunk_, const bool clampToAlpha_) noexcept
+            : srcData (srcData_), destData (destData_), xWeights (xWeights_), yWeights (yWeights_),
+              rowsPerChunk (rowsPerChunk_), clampToAlpha (clampToAlpha_)
+        {}
+
+        void operator() (const int chunk) const
+        {
+            const int numValues = destData.width * destData.pixelStride;
+            const int ringSize = yWeights.getMaxTaps();
+
+            HeapBlock<float> ring ((size_t) (ringSize * numValues)), totals ((size_t) numValues);
+            HeapBlock<int> ringRows ((size_t) ringSize);
+
+            for (int i = 0; i < ringSize; ++i)
+                ringRows[i] = -1;
+
+            const int endRow = jmin (destData.height, (chunk + 1) * rowsPerChunk);
+
+            for (int y = chunk * rowsPerChunk; y < endRow; ++y)
+            {
+                zeromem (totals, sizeof (float) * (size_t) numValues);
+
+                const float* const w = yWeights.getWeights (y);
+                const int firstRow = yWeights.getFirstIndex (y);
+
+                for (int i = 0; i < yWeights.getNumTaps (y); ++i)
+                {
+                    const int srcRow = firstRow + i;
+                    const int slot = srcRow % ringSize;
+                    float* const row = ring + slot * numValues;
+
+                    if (ringRows [slot] != srcRow)
+                    {
+                        resampleRow (srcData.getLinePointer (srcRow), row, destData.width, destData.pixelStride, xWeights);
+                        ringRows [slot] = srcRow;
+                    }
+
+                    addWeightedRow (totals, row, w[i], numValues);
+                }
+
+                uint8* const d = destData.getLinePointer (y);
+
+                for (int x = 0; x < numValues; ++x)
+                    d[x] = (uint8) jlimit (0, 255, roundToInt (totals[x]));
+
+                // cubic filters can overshoot, which would leave premultiplied colours brighter than their alpha
+                if (clampToAlpha)
+                {
+                    for (int x = 0; x < destData.width; ++x)
+                    {
+                        uint8* const p = d + x * 4;
+                        const uint8 alpha = p [PixelARGB::indexA];
+
+                        for (int c = 0; c < 4; ++c)
+                            p[c] = jmin (p[c], alpha);
+                    }
+                }
+            }
+        }
+
+        const Image::BitmapData& srcData;
+        const Image::BitmapData& destData;
+        const Weights& xWeights;
+        const Weights& yWeights;
+        const int rowsPerChunk;
+        const bool clampToAlpha;
+
+        JUCE_DECLARE_NON_COPYABLE (ResampleChunkOp);
+    };
+
+    //==============================================================================
+    /*  Makes one level of a mip-chain: each destination pixel is the average of a 2x2 block. */
+    struct HalveOp
+    {
+        HalveOp (const Image::BitmapData& srcData_, const Image::BitmapData& destData_) noexcept
+            : srcData (srcData_), destData (destData_)
+        {}
+
+        void operator() (const int y) const noexcept
+        {
+            const uint8* s0 = srcData.getLinePointer (y * 2);
+            const uint8* s1 = srcData.getLinePointer (y * 2 + 1);
+            uint8* d = destData.getLinePointer (y);
+            const int numChannels = destData.pixelStride;
+            int x = 0;
+
+           #if JUCE_USE_SSE2_PIXEL_OPS
+            if (numChannels == 4 && ImagePixelOps::canUseSSE2())
+            {
+                const __m128i zero (_mm_setzero_si128());
+                const __m128i two (_mm_set1_epi16 (2));
+
+                for (; x < destData.width - 1; x += 2, s0 += 16, s1 += 16, d += 8)
+                {
+                    const __m128i a (_mm_loadu_si128 ((const __m128i*) s0));
+                    const __m128i b (_mm_loadu_si128 ((const __m128i*) s1));
+                    const __m128i lo (_mm_add_epi16 (_mm_unpacklo_epi8 (a, zero), _mm_unpacklo_epi8 (b, zero)));
+                    const __m128i hi (_mm_add_epi16 (_mm_unpackhi_epi8 (a, zero), _mm_unpackhi_epi8 (b, zero)));
+                    const __m128i sums (_mm_unpacklo_epi64 (_mm_add_epi16 (lo, _mm_srli_si128 (lo, 8)),
+                                                            _mm_add_epi16 (hi, _mm_srli_si128 (hi, 8))));
+
+                    _mm_storel_epi64 ((__m128i*) d, _mm_packus_epi16 (_mm_srli_epi16 (_mm_add_epi16 (sums, two), 2), zero));
+                }
+            }
+           #endif
+
+            for (; x < destData.width; ++x, s0 += numChannels * 2, s1 += numChannels * 2)
+                for (int c = 0; c < numChannels; ++c)
+                    *d++ = (uint8) ((s0[c] + s0[c + numChannels] + s1[c] + s1[c + numChannels] + 2) >> 2);
+        }
+
+        const Image::BitmapData& srcData;
+        const Image::BitmapData& destData;
+
+        JUCE_DECLARE_NON_COPYABLE (HalveOp);
+    };
+
+    static FilterType chooseFilter (const int srcSize, const int destSize, const Graphics::ResamplingQuality quality) noexcept
+    {
+        if (quality == Graphics::highResamplingQuality)
+            return destSize * 2 <= srcSize ? boxFilter : mitchellFilter;
+
+        return destSize < srcSize ? boxFilter : tentFilter;
+    }
+
+    static void resample (const Image::BitmapData& srcData, const Image::BitmapData& destData,
+                          const Graphics::ResamplingQuality quality)
+    {
+        // While the source is at least twice the destination size, it's much quicker to
+        // average it down through a chain of half-size images before filtering.
+        if (destData.width * 2 <= srcData.width && destData.height * 2 <= srcData.height
+             && (srcData.width & 1) == 0 && (srcData.height & 1) == 0)
+        {
+            Image half (srcData.pixelFormat, srcData.width / 2, srcData.height / 2, false, SoftwareImageType());
+            const Image::BitmapData halfData (half, Image::BitmapData::readWrite);
+
+            if (halfData.pixelStride == srcData.pixelStride)
+            {
+                ImagePixelOps::processRows (halfData.width, halfData.height, HalveOp (srcData, halfData));
+                resample (halfData, destData, quality);
+                return;
+            }
+        }
+
+        const FilterType xFilter = chooseFilter (srcData.width,  destData.width,  quality);
+        const FilterType yFilter = chooseFilter (srcData.height, destData.height, quality);
+
+        const Weights xWeights (srcData.width,  destData.width,  xFilter);
+        const Weights yWeights (srcData.height, destData.height, yFilter);
+
+        const int rowsPerChunk = 64;
+        const int numChunks = (destData.height + rowsPerChunk - 1) / rowsPerChunk;
+
+        // (each chunk is a band's worth of work on its own, so a band only needs one of them)
+        const int pixelsPerChunk = jmax (srcData.width * srcData.height, destData.width * destData.height) / numChunks;
+
+        ImagePixelOps::processRows (pixelsPerChunk, numChunks,
+                                    ResampleChunkOp (srcData, destData, xWeights, yWeights, rowsPerChunk,
+                                                     srcData.pixelFormat == Image::ARGB
+                                                       && (xFilter == mitchellFilter || yFilter == mitchellFilter)),
+                                    1);
+    }
+}
+
 Image Image::rescaled (const int newWidth, const int newHeight, const Graphics::ResamplingQuality quality) const
 {
     if (image == nullptr || (image->width == newWidth && image->height == newHeight))
@@ -261,6 +961,22 @@ Image Image::rescaled (const int newWidth, const int newHeight, const Graphics::
     const ScopedPointer<ImageType> type (image->createType());
     Image newImage (type->create (image->pixelFormat, newWidth, newHeight, hasAlphaChannel()));
 
+    const bool isShrinking = newWidth < image->width || newHeight < image->height;
+
+    if (newWidth > 0 && newHeight > 0
+         && (quality == Graphics::highResamplingQuality
+              || (quality == Graphics::mediumResamplingQuality && isShrinking)))
+    {
+        const BitmapData srcData (*this, 0, 0, image->width, image->height);
+        const BitmapData destData (newImage, 0, 0, newWidth, newHeight, BitmapData::writeOnly);
+
+        if (srcData.pixelStride == destData.pixelStride)
+        {
+            ImageResampling::resample (srcData, destData, quality);
+            return newImage;
+        }
+    }
+
     Graphics g (newImage);
     g.setImageResamplingQuality (quality);
     g.drawImage (*this, 0, 0, newWidth, newHeight, 0, 0, image->width, image->height, false);
@@ -289,14 +1005,10 @@ Image Image::convertedToFormat (PixelFormat newFormat) const
             const BitmapData destData (newImage, 0, 0, w, h, BitmapData::writeOnly);
             const BitmapData srcData (*this, 0, 0, w, h);
 
-            for (int y = 0; y < h; ++y)
-            {
-                const PixelARGB* const src = (const PixelARGB*) srcData.getLinePointer (y);
-                uint8* const dst = destData.getLinePointer (y);
-
-                for (int x = 0; x < w; ++x)
-                    dst[x] = src[x].getAlpha();
-            }
+            if (srcData.pixelStride == (int) sizeof (PixelARGB) && destData.pixelStride == 1)
+                ImagePixelOps::processRows (w, h, ImagePixelOps::CopyAlphaChannelOp (srcData, destData));
+            else
+                ImagePixelOps::convertPixels<PixelARGB, PixelAlpha> (srcData, destData);
         }
     }
     else if (image->pixelFormat == SingleChannel && newFormat == Image::ARGB)
@@ -304,14 +1016,17 @@ Image Image::convertedToFormat (PixelFormat newFormat) const
         const BitmapData destData (newImage, 0, 0, w, h, BitmapData::writeOnly);
         const BitmapData srcData (*this, 0, 0, w, h);
 
-        for (int y = 0; y < h; ++y)
-        {
-            const PixelAlpha* const src = (const PixelAlpha*) srcData.getLinePointer (y);
-            PixelARGB* const dst = (PixelARGB*) destData.getLinePointer (y);
+        if (srcData.pixelStride == 1 && destData.pixelStride == (int) sizeof (PixelARGB))
+            ImagePixelOps::processRows (w, h, ImagePixelOps::ExpandAlphaChannelOp (srcData, destData));
+        else
+            ImagePixelOps::convertPixels<PixelAlpha, PixelARGB> (srcData, destData);
+    }
+    else if (image->pixelFormat == RGB && newFormat == Image::ARGB)
+    {
+        const BitmapData destData (newImage, 0, 0, w, h, BitmapData::writeOnly);
+        const BitmapData srcData (*this, 0, 0, w, h);
 
-            for (int x = 0; x < w; ++x)
-                dst[x].set (src[x]);
-        }
+        ImagePixelOps::convertPixels<PixelRGB, PixelARGB> (srcData, destData);
     }
     else
     {
@@ -406,9 +1121,15 @@ void Image::BitmapData::setPixelColour (const int x, const int y, const Colour&
 //==============================================================================
 void Image::clear (const Rectangle<int>& area, const Colour& colourToClearTo)
 {
-    const ScopedPointer<LowLevelGraphicsContext> g (image->createLowLevelContext());
-    g->setFill (colourToClearTo);
-    g->fillRect (area, true);
+    const Rectangle<int> clipped (area.getIntersection (getBounds()));
+
+    if (! clipped.isEmpty())
+    {
+        const BitmapData destData (*this, clipped.getX(), clipped.getY(),
+                                   clipped.getWidth(), clipped.getHeight(), BitmapData::writeOnly);
+
+        ImagePixelOps::fill (destData, colourToClearTo.getPixelARGB());
+    }
 }
 
 //==============================================================================
@@ -446,37 +1167,6 @@ void Image::multiplyAlphaAt (const int x, const int y, const float multiplier)
     }
 }
 
-template <class PixelType>
-struct PixelIterator
-{
-    template <class PixelOperation>
-    static void iterate (const Image::BitmapData& data, const PixelOperation& pixelOp)
-    {
-        for (int y = 0; y < data.height; ++y)
-        {
-            uint8* p = data.getLinePointer (y);
-
-            for (int x = 0; x < data.width; ++x)
-            {
-                pixelOp (*(PixelType*) p);
-                p += data.pixelStride;
-            }
-        }
-    }
-};
-
-template <class PixelOperation>
-static void performPixelOp (const Image::BitmapData& data, const PixelOperation& pixelOp)
-{
-    switch (data.pixelFormat)
-    {
-        case Image::ARGB:           PixelIterator<PixelARGB> ::iterate (data, pixelOp); break;
-        case Image::RGB:            PixelIterator<PixelRGB>  ::iterate (data, pixelOp); break;
-        case Image::SingleChannel:  PixelIterator<PixelAlpha>::iterate (data, pixelOp); break;
-        default:                    jassertfalse; break;
-    }
-}
-
 struct AlphaMultiplyOp
 {
     AlphaMultiplyOp (float alpha_) noexcept : alpha (alpha_) {}
@@ -492,29 +1182,34 @@ struct AlphaMultiplyOp
     JUCE_DECLARE_NON_COPYABLE (AlphaMultiplyOp);
 };
 
-void Image::multiplyAllAlphas (const float amountToMultiplyBy)
-{
-    jassert (hasAlphaChannel());
-
-    const BitmapData destData (*this, 0, 0, getWidth(), getHeight(), BitmapData::readWrite);
-    performPixelOp (destData, AlphaMultiplyOp (amountToMultiplyBy));
-}
-
 struct DesaturateOp
 {
     template <class PixelType>
-    void operator() (PixelType& pixel) const
+    void operator() (PixelType& pixel) const noexcept
     {
         pixel.desaturate();
     }
 };
 
+void Image::multiplyAllAlphas (const float amountToMultiplyBy)
+{
+    jassert (hasAlphaChannel());
+
+    const BitmapData destData (*this, 0, 0, getWidth(), getHeight(), BitmapData::readWrite);
+
+    if (destData.pixelFormat == ARGB && destData.pixelStride == (int) sizeof (PixelARGB))
+        ImagePixelOps::processRows (destData.width, destData.height,
+                                    ImagePixelOps::MultiplyAlphaOp (destData, (int) (amountToMultiplyBy * 255.0f)));
+    else
+        ImagePixelOps::performPixelOp (destData, AlphaMultiplyOp (amountToMultiplyBy));
+}
+
 void Image::desaturate()
 {
     if (isARGB() || isRGB())
     {
         const BitmapData destData (*this, 0, 0, getWidth(), getHeight(), BitmapData::readWrite);
-        performPixelOp (destData, DesaturateOp());
+        ImagePixelOps::performPixelOp (destData, DesaturateOp());
     }
 }
 
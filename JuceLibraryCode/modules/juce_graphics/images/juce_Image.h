@@ -194,6 +194,11 @@ public:
 
         A new image is returned which is a copy of this one, rescaled to the given size.
 
+        With mediumResamplingQuality, shrinking is done by averaging the area of source pixels
+        that each new pixel covers. With highResamplingQuality, a Mitchell filter is used for
+        enlarging or mild reductions, and area-averaging for anything smaller than half-size.
+        lowResamplingQuality just draws the image using the normal renderer.
+
         Note that if the new size is identical to the existing image, this will just return
         a reference to the original image, and won't actually create a duplicate.
     */
@@ -198,6 +198,59 @@ public:
     GIFImageFormat();
     ~GIFImageFormat();
 
+    //==============================================================================
+    /**
+        Gives access to all the frames of an animated GIF.
+
+        Creating one of these just scans the data to find where its frames are - each
+        frame is only decompressed when getFrame() is called for it. The frames that are
+        returned are the full size of the animation, with any earlier frames that show
+        through them already composited, so they can be drawn directly.
+
+        Asking for the frames in order is cheap, but going back to an earlier frame means
+        decoding the sequence again from the start.
+    */
+    class JUCE_API  Animation
+    {
+    public:
+        /** Reads the GIF data from a stream.
+            The whole stream is read into memory, so it isn't needed after the constructor returns.
+        */
+        Animation (InputStream& input);
+
+        /** Destructor. */
+        ~Animation();
+
+        /** Returns the number of frames in the file, or 0 if it couldn't be read. */
+        int getNumFrames() const noexcept;
+
+        /** Returns the width of the animation. */
+        int getWidth() const noexcept;
+
+        /** Returns the height of the animation. */
+        int getHeight() const noexcept;
+
+        /** Returns the number of milliseconds that a frame should be shown for.
+            Note that a lot of files use 0 here, which browsers generally treat as 100ms.
+        */
+        int getFrameDelay (int frameIndex) const noexcept;
+
+        /** Returns the number of times the animation should be played, or 0 if it should loop forever. */
+        int getNumLoops() const noexcept;
+
+        /** Decodes and returns one of the frames, as an ARGB image.
+            If the index is out of range, this returns a null image.
+        */
+        Image getFrame (int frameIndex);
+
+    private:
+        class Pimpl;
+        friend class ScopedPointer <Pimpl>;
+        ScopedPointer <Pimpl> pimpl;
+
+        JUCE_DECLARE_NON_COPYABLE (Animation);
+    };
+
     //==============================================================================
     String getFormatName();
     bool canUnderstand (InputStream& input);
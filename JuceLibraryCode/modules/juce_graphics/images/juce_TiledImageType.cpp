@@ -0,0 +1,403 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library - "Jules' Utility Class Extensions"
+   Copyright 2004-11 by Raw Material Software Ltd.
+
+  ------------------------------------------------------------------------------
+
+   JUCE can be redistributed and/or modified under the terms of the GNU General
+   Public License (Version 2), as published by the Free Software Foundation.
+   A copy of the license is included in the JUCE distribution, or can be found
+   online at www.gnu.org/licenses.
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+  ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.rawmaterialsoftware.com/juce for more information.
+
+  ==============================================================================
+*/
+
+//==============================================================================
+class TiledPixelData  : public ImagePixelData
+{
+public:
+    TiledPixelData (const Image::PixelFormat format_, const int w, const int h, const bool useScratchFile,
+                    TiledImageType::TileSource* const source_, const int maxTilesInMemory_)
+        : ImagePixelData (format_, w, h),
+          pixelStride (format_ == Image::RGB ? 3 : ((format_ == Image::ARGB) ? 4 : 1)),
+          tileLineStride (pixelStride * tileSize),
+          tileBytes ((size_t) (tileLineStride * tileSize)),
+          numTilesX ((w + tileSize - 1) / tileSize),
+          numTilesY ((h + tileSize - 1) / tileSize),
+          source (source_),
+          maxTilesInMemory (jmax (4, maxTilesInMemory_)),
+          useCounter (0)
+    {
+        tiles.ensureStorageAllocated (numTilesX * numTilesY);
+
+        for (int i = numTilesX * numTilesY; --i >= 0;)
+            tiles.add (nullptr);
+
+        if (useScratchFile && source == nullptr)
+            createScratchFile();
+    }
+
+    LowLevelGraphicsContext* createLowLevelContext()
+    {
+        return new LowLevelGraphicsSoftwareRenderer (Image (this));
+    }
+
+    void initialiseBitmapData (Image::BitmapData& bitmap, int x, int y, Image::BitmapData::ReadWriteMode mode)
+    {
+        bitmap.pixelFormat = pixelFormat;
+        bitmap.pixelStride = pixelStride;
+
+        const Rectangle<int> area (x, y, jmax (1, bitmap.width), jmax (1, bitmap.height));
+        const int tileX = area.getX() / tileSize;
+        const int tileY = area.getY() / tileSize;
+
+        if ((area.getRight() - 1) / tileSize == tileX && (area.getBottom() - 1) / tileSize == tileY)
+        {
+            // The area lies inside one tile, so the caller can use the tile's memory directly..
+            const int offset = (area.getY() - tileY * tileSize) * tileLineStride
+                                 + (area.getX() - tileX * tileSize) * pixelStride;
+            bitmap.lineStride = tileLineStride;
+
+            const ScopedLock sl (lock);
+
+            if (mode == Image::BitmapData::readOnly && ! isTilePreloaded (tileX, tileY))
+            {
+                bitmap.data = getEmptyTile() + offset;
+            }
+            else
+            {
+                Tile& tile = getTile (tileX, tileY);
+                bitmap.data = tile.data + offset;
+                bitmap.dataReleaser = new TilePin (*this, tile, mode != Image::BitmapData::readOnly);
+            }
+        }
+        else
+        {
+            CopiedArea* const copy = new CopiedArea (*this, area, mode);
+            bitmap.data = copy->data;
+            bitmap.lineStride = copy->lineStride;
+            bitmap.dataReleaser = copy;
+        }
+    }
+
+    ImagePixelData* clone()
+    {
+        TiledPixelData* const s = new TiledPixelData (pixelFormat, width, height, mappedFile != nullptr,
+                                                      source, maxTilesInMemory);
+        const ScopedLock sl (lock);
+
+        for (int i = 0; i < tiles.size(); ++i)
+        {
+            const Tile* const tile = tiles.getUnchecked (i);
+
+            // (unmodified tiles from a source can just be reloaded by the copy when it needs them)
+            if (tile != nullptr && (source == nullptr || tile->isModified))
+            {
+                Tile& newTile = s->createTile (i);
+                memcpy (newTile.data, tile->data, tileBytes);
+                newTile.isModified = tile->isModified;
+            }
+        }
+
+        return s;
+    }
+
+    ImageType* createType() const    { return new TiledImageType (mappedFile != nullptr); }
+
+private:
+    //==============================================================================
+    enum { tileSize = TiledImageType::tileSize };
+
+    struct Tile
+    {
+        Tile (const int index_) noexcept
+            : data (nullptr), index (index_), pinCount (0), lastUsed (0), isModified (false)
+        {}
+
+        HeapBlock<uint8> storage;
+        uint8* data;
+        const int index;
+        int pinCount;
+        uint32 lastUsed;
+        bool isModified;
+
+        JUCE_DECLARE_NON_COPYABLE (Tile);
+    };
+
+    //==============================================================================
+    class TilePin  : public Image::BitmapData::BitmapDataReleaser
+    {
+    public:
+        TilePin (TiledPixelData& owner_, Tile& tile_, const bool willBeModified)
+            : owner (owner_), tile (tile_)
+        {
+            ++tile.pinCount;
+
+            if (willBeModified)
+                tile.isModified = true;
+        }
+
+        ~TilePin()
+        {
+            const ScopedLock sl (owner.lock);
+            --tile.pinCount;
+        }
+
+    private:
+        TiledPixelData& owner;
+        Tile& tile;
+
+        JUCE_DECLARE_NON_COPYABLE (TilePin);
+    };
+
+    class CopiedArea  : public Image::BitmapData::BitmapDataReleaser
+    {
+    public:
+        CopiedArea (TiledPixelData& owner_, const Rectangle<int>& area_, const Image::BitmapData::ReadWriteMode mode_)
+            : lineStride ((owner_.pixelStride * area_.getWidth() + 3) & ~3),
+              owner (owner_), area (area_), mode (mode_)
+        {
+            data.calloc ((size_t) (lineStride * area.getHeight()));
+
+            if (mode != Image::BitmapData::writeOnly)
+                owner.copyArea (area, data, lineStride, false);
+        }
+
+        ~CopiedArea()
+        {
+            if (mode != Image::BitmapData::readOnly)
+                owner.copyArea (area, data, lineStride, true);
+        }
+
+        HeapBlock<uint8> data;
+        const int lineStride;
+
+    private:
+        TiledPixelData& owner;
+        const Rectangle<int> area;
+        const Image::BitmapData::ReadWriteMode mode;
+
+        JUCE_DECLARE_NON_COPYABLE (CopiedArea);
+    };
+
+    friend class TilePin;
+    friend class CopiedArea;
+
+    //==============================================================================
+    const int pixelStride, tileLineStride;
+    const size_t tileBytes;
+    const int numTilesX, numTilesY;
+    OwnedArray<Tile> tiles;
+    Array<Tile*> residentTiles;
+    HeapBlock<uint8> emptyTile;
+    ScopedPointer<TemporaryFile> scratchFile;
+    ScopedPointer<MemoryMappedFile> mappedFile;
+    TiledImageType::TileSource::Ptr source;
+    const int maxTilesInMemory;
+    uint32 useCounter;
+    CriticalSection lock;
+
+    //==============================================================================
+    void createScratchFile()
+    {
+        const int64 totalSize = (int64) tileBytes * numTilesX * numTilesY;
+
+        if ((int64) (size_t) totalSize != totalSize)
+            return; // too big to map on a 32-bit system
+
+        scratchFile = new TemporaryFile (".tiles");
+
+        {
+            FileOutputStream out (scratchFile->getFile());
+
+            if (out.failedToOpen() || ! out.setPosition (totalSize - 1))
+            {
+                scratchFile = nullptr;
+                return;
+            }
+
+            out.writeByte (0);
+        }
+
+        mappedFile = new MemoryMappedFile (scratchFile->getFile(), MemoryMappedFile::readWrite);
+
+        if (mappedFile->getData() == nullptr || (int64) mappedFile->getSize() < totalSize)
+        {
+            mappedFile = nullptr;
+            scratchFile = nullptr;
+        }
+    }
+
+    // Tiles that were never created are blank, unless they're loaded from a source.
+    bool isTilePreloaded (const int tileX, const int tileY) const noexcept
+    {
+        return source != nullptr || mappedFile != nullptr
+                || tiles.getUnchecked (tileY * numTilesX + tileX) != nullptr;
+    }
+
+    uint8* getEmptyTile()
+    {
+        if (emptyTile == nullptr)
+            emptyTile.calloc (tileBytes);
+
+        return emptyTile;
+    }
+
+    Tile& createTile (const int index)
+    {
+        if (source != nullptr)
+            discardUnusedTiles();
+
+        Tile* const tile = new Tile (index);
+        tiles.set (index, tile);
+
+        if (mappedFile != nullptr)
+        {
+            tile->data = static_cast <uint8*> (mappedFile->getData()) + tileBytes * (size_t) index;
+        }
+        else
+        {
+            tile->storage.calloc (tileBytes);
+            tile->data = tile->storage;
+        }
+
+        if (source != nullptr)
+            residentTiles.add (tile);
+
+        return *tile;
+    }
+
+    // (must be called with the lock held)
+    Tile& getTile (const int tileX, const int tileY)
+    {
+        const int index = tileY * numTilesX + tileX;
+        Tile* tile = tiles.getUnchecked (index);
+
+        if (tile == nullptr)
+        {
+            tile = &createTile (index);
+
+            if (source != nullptr)
+            {
+                const Rectangle<int> tileArea (Rectangle<int> (tileX * tileSize, tileY * tileSize, tileSize, tileSize)
+                                                 .getIntersection (Rectangle<int> (width, height)));
+
+                ++(tile->pinCount);
+
+                {
+                    // (this re-enters initialiseBitmapData, which will find the new tile)
+                    Image thisImage (this);
+                    const Image::BitmapData destData (thisImage, tileArea.getX(), tileArea.getY(),
+                                                      tileArea.getWidth(), tileArea.getHeight(),
+                                                      Image::BitmapData::writeOnly);
+                    source->fillTile (tileArea, destData);
+                }
+
+                --(tile->pinCount);
+                tile->isModified = false;
+            }
+        }
+
+        tile->lastUsed = ++useCounter;
+        return *tile;
+    }
+
+    void discardUnusedTiles()
+    {
+        while (residentTiles.size() >= maxTilesInMemory)
+        {
+            Tile* oldest = nullptr;
+
+            for (int i = residentTiles.size(); --i >= 0;)
+            {
+                Tile* const t = residentTiles.getUnchecked (i);
+
+                if (t->pinCount == 0 && ! t->isModified
+                     && (oldest == nullptr || t->lastUsed < oldest->lastUsed))
+                    oldest = t;
+            }
+
+            if (oldest == nullptr)
+                break;
+
+            residentTiles.removeValue (oldest);
+            tiles.set (oldest->index, nullptr);
+        }
+    }
+
+    void copyArea (const Rectangle<int>& area, uint8* const buffer, const int bufferLineStride, const bool writeToTiles)
+    {
+        const ScopedLock sl (lock);
+
+        for (int tileY = area.getY() / tileSize; tileY <= (area.getBottom() - 1) / tileSize; ++tileY)
+        {
+            for (int tileX = area.getX() / tileSize; tileX <= (area.getRight() - 1) / tileSize; ++tileX)
+            {
+                if (! (writeToTiles || isTilePreloaded (tileX, tileY)))
+                    continue; // (the buffer's already blank)
+
+                const Rectangle<int> tileArea (tileX * tileSize, tileY * tileSize, tileSize, tileSize);
+                const Rectangle<int> overlap (tileArea.getIntersection (area));
+                const size_t numBytes = (size_t) (overlap.getWidth() * pixelStride);
+
+                Tile& tile = getTile (tileX, tileY);
+
+                if (writeToTiles)
+                    tile.isModified = true;
+
+                for (int y = overlap.getY(); y < overlap.getBottom(); ++y)
+                {
+                    uint8* const tileLine = tile.data + (y - tileArea.getY()) * tileLineStride
+                                                      + (overlap.getX() - tileArea.getX()) * pixelStride;
+                    uint8* const bufferLine = buffer + (y - area.getY()) * bufferLineStride
+                                                     + (overlap.getX() - area.getX()) * pixelStride;
+
+                    if (writeToTiles)
+                        memcpy (tileLine, bufferLine, numBytes);
+                    else
+                        memcpy (bufferLine, tileLine, numBytes);
+                }
+            }
+        }
+    }
+
+    JUCE_LEAK_DETECTOR (TiledPixelData);
+};
+
+//==============================================================================
+TiledImageType::TiledImageType (const bool useMemoryMappedScratchFile_)
+    : useMemoryMappedScratchFile (useMemoryMappedScratchFile_)
+{
+}
+
+TiledImageType::~TiledImageType() {}
+
+ImagePixelData* TiledImageType::create (Image::PixelFormat format, int width, int height, bool) const
+{
+    // (the tiles always start off blank)
+    return new TiledPixelData (format, width, height, useMemoryMappedScratchFile, nullptr, 0);
+}
+
+Image TiledImageType::createImage (Image::PixelFormat format, int width, int height,
+                                   TileSource* source, int maxTilesInMemory)
+{
+    jassert (source != nullptr);
+    return Image (new TiledPixelData (format, width, height, false, source, maxTilesInMemory));
+}
+
+int TiledImageType::getTypeID() const
+{
+    // (the small numbers are taken by the library's other image types, including OpenGLImageType)
+    return 0x54696c65; // 'Tile'
+}
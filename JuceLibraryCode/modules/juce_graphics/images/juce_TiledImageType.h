@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library - "Jules' Utility Class Extensions"
+   Copyright 2004-11 by Raw Material Software Ltd.
+
+  ------------------------------------------------------------------------------
+
+   JUCE can be redistributed and/or modified under the terms of the GNU General
+   Public License (Version 2), as published by the Free Software Foundation.
+   A copy of the license is included in the JUCE distribution, or can be found
+   online at www.gnu.org/licenses.
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+  ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.rawmaterialsoftware.com/juce for more information.
+
+  ==============================================================================
+*/
+
+#ifndef __JUCE_TILEDIMAGETYPE_JUCEHEADER__
+#define __JUCE_TILEDIMAGETYPE_JUCEHEADER__
+
+#include "juce_Image.h"
+
+
+//==============================================================================
+/**
+    An image storage type which keeps its pixels in separate square tiles, which are
+    only created when something actually touches them.
+
+    This is intended for very large images, where only a small part is likely to be
+    looked at any one time. A 30000x30000 image of this type takes up almost no
+    memory until areas of it are read or written, and drawing part of it with a
+    Graphics context only fetches the tiles that are visible.
+
+    The tiles can either be kept on the heap, or in a memory-mapped temporary file,
+    so that the OS can page them out when memory is tight. Alternatively, use
+    createImage() with a TileSource to create an image whose tiles are loaded or
+    decoded on demand, and discarded again when too many are held in memory.
+
+    Accessing an area that lies inside a single tile with Image::BitmapData is
+    very cheap, but areas that straddle tile boundaries have to be copied into
+    (and for writable access, back out of) a temporary buffer. Drawing into a
+    tiled image with a Graphics context works, but accesses the whole image, so
+    it's best avoided for big images.
+
+    @see ImageType, SoftwareImageType
+*/
+class JUCE_API  TiledImageType   : public ImageType
+{
+public:
+    //==============================================================================
+    /** Creates the type.
+        If useMemoryMappedScratchFile is true, each image's tiles will be stored in a
+        memory-mapped temporary file, rather than in memory.
+    */
+    TiledImageType (bool useMemoryMappedScratchFile = false);
+
+    /** Destructor. */
+    ~TiledImageType();
+
+    //==============================================================================
+    /** The width and height of the tiles, in pixels. */
+    enum { tileSize = 256 };
+
+    //==============================================================================
+    /**
+        Supplies the pixels for the tiles of an image created with createImage().
+
+        fillTile() may be called on any thread that accesses the image, and may be
+        called again for the same area if the tile was discarded to save memory.
+    */
+    class JUCE_API  TileSource  : public ReferenceCountedObject
+    {
+    public:
+        /** Destructor. */
+        virtual ~TileSource() {}
+
+        /** Must fill the given bitmap with the pixels of the given area of the image.
+            The bitmap is the same size as the area, which will be at most tileSize pixels
+            square.
+        */
+        virtual void fillTile (const Rectangle<int>& area, const Image::BitmapData& destData) = 0;
+
+        typedef ReferenceCountedObjectPtr<TileSource> Ptr;
+    };
+
+    /** Creates a tiled image whose tiles are loaded from a TileSource when they're first needed.
+
+        Tiles that haven't been modified are discarded when more than maxTilesInMemory are
+        held, and will be re-loaded from the source if they're needed again.
+    */
+    static Image createImage (Image::PixelFormat format, int width, int height,
+                              TileSource* source, int maxTilesInMemory = 256);
+
+    //==============================================================================
+    ImagePixelData* create (Image::PixelFormat, int width, int height, bool clearImage) const;
+    int getTypeID() const;
+
+private:
+    bool useMemoryMappedScratchFile;
+};
+
+
+#endif   // __JUCE_TILEDIMAGETYPE_JUCEHEADER__
@@ -63,6 +63,14 @@
  #undef SIZEOF
 #endif
 
+#if JUCE_INTEL && (JUCE_64BIT || JUCE_MSVC || defined (__SSE2__)) && ! defined (JUCE_USE_SSE2_PIXEL_OPS)
+ #define JUCE_USE_SSE2_PIXEL_OPS 1
+#endif
+
+#if JUCE_USE_SSE2_PIXEL_OPS
+ #include <emmintrin.h>
+#endif
+
 //==============================================================================
 namespace juce
 {
@@ -88,6 +96,7 @@ namespace juce
 #include "images/juce_ImageCache.cpp"
 #include "images/juce_ImageConvolutionKernel.cpp"
 #include "images/juce_ImageFileFormat.cpp"
+#include "images/juce_TiledImageType.cpp"
 #include "image_formats/juce_GIFLoader.cpp"
 #include "image_formats/juce_JPEGLoader.cpp"
 #include "image_formats/juce_PNGLoader.cpp"
@@ -142,6 +142,9 @@ namespace juce
 #ifndef __JUCE_IMAGEFILEFORMAT_JUCEHEADER__
  #include "images/juce_ImageFileFormat.h"
 #endif
+#ifndef __JUCE_TILEDIMAGETYPE_JUCEHEADER__
+ #include "images/juce_TiledImageType.h"
+#endif
 #ifndef __JUCE_ATTRIBUTEDSTRING_JUCEHEADER__
  #include "fonts/juce_AttributedString.h"
 #endif
@@ -289,6 +289,17 @@ private:
 };
 
 //==============================================================================
+/*  A stack of states for a renderer.
+
+    The current state always sits at the top of the stack, and saving it pushes a copy, so
+    the copy can be modified while the original waits to be restored. The memory used by
+    popped states is kept and re-used, so a save/restore pair doesn't touch the heap once
+    the stack has been as deep as it's going to go.
+
+    The StateObjectType must be copy-constructable, and needs these methods:
+        void beginTransparencyLayer (float opacity);        // turns this copy into a layer
+        void endTransparencyLayer (StateObjectType& layer); // composites a finished layer
+*/
 template <class StateObjectType>
 class SavedStateStack
 {
@@ -297,22 +308,41 @@ public:
         : currentState (initialState)
     {}
 
+    ~SavedStateStack()
+    {
+        if (stack.size() > 0)
+        {
+            recycle (currentState);
+
+            for (int i = stack.size(); --i > 0;)
+                recycle (stack.getUnchecked (i));
+
+            currentState = stack.getUnchecked (0);
+        }
+
+        delete currentState; // (the initial state was allocated by the caller)
+
+        for (int i = spareSpace.size(); --i >= 0;)
+            ::operator delete (spareSpace.getUnchecked (i));
+    }
+
     inline StateObjectType* operator->() const noexcept     { return currentState; }
     inline StateObjectType& operator*()  const noexcept     { return *currentState; }
 
     void save()
     {
-        stack.add (new StateObjectType (*currentState));
+        StateObjectType* const copy = new (getSpaceForNewState()) StateObjectType (*currentState);
+        stack.add (currentState);
+        currentState = copy;
     }
 
     void restore()
     {
-        StateObjectType* const top = stack.getLast();
-
-        if (top != nullptr)
+        if (stack.size() > 0)
         {
-            currentState = top;
-            stack.removeLast (1, false);
+            recycle (currentState);
+            currentState = stack.getLast();
+            stack.removeLast();
         }
         else
         {
@@ -323,19 +353,48 @@ public:
     void beginTransparencyLayer (float opacity)
     {
         save();
-        currentState = currentState->beginTransparencyLayer (opacity);
+        currentState->beginTransparencyLayer (opacity);
     }
 
     void endTransparencyLayer()
     {
-        const ScopedPointer<StateObjectType> finishedTransparencyLayer (currentState);
-        restore();
-        currentState->endTransparencyLayer (*finishedTransparencyLayer);
+        if (stack.size() > 0)
+        {
+            StateObjectType* const finishedTransparencyLayer = currentState;
+            currentState = stack.getLast();
+            stack.removeLast();
+
+            currentState->endTransparencyLayer (*finishedTransparencyLayer);
+            recycle (finishedTransparencyLayer);
+        }
+        else
+        {
+            jassertfalse; // trying to pop with an empty stack!
+        }
     }
 
 private:
-    ScopedPointer<StateObjectType> currentState;
-    OwnedArray<StateObjectType> stack;
+    StateObjectType* currentState;
+    Array<StateObjectType*> stack;
+    Array<void*> spareSpace;
+
+    void* getSpaceForNewState()
+    {
+        if (spareSpace.size() > 0)
+        {
+            void* const space = spareSpace.getLast();
+            spareSpace.removeLast();
+            return space;
+        }
+
+        return ::operator new (sizeof (StateObjectType));
+    }
+
+    void recycle (StateObjectType* const state)
+    {
+        state->~StateObjectType();
+        spareSpace.add (state);
+    }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SavedStateStack);
 };
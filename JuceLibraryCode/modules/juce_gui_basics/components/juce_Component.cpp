@@ -193,12 +193,28 @@ struct Component::ComponentHelpers
     }
    #endif
 
-    static Identifier getColourPropertyId (const int colourId)
+    // Returns the index of the colour if it's been set, or the bitwise complement of
+    // the index at which it should be inserted if it hasn't.
+    static int findExplicitColour (const Component& comp, const int colourId) noexcept
     {
-        String s;
-        s.preallocateBytes (32);
-        s << "jcclr_" << String::toHexString (colourId);
-        return s;
+        const Array<ExplicitColour>& colours = comp.explicitColours;
+        int start = 0, end = colours.size();
+
+        while (start < end)
+        {
+            const int mid = (start + end) >> 1;
+            const int midId = colours.getReference (mid).colourId;
+
+            if (midId == colourId)
+                return mid;
+
+            if (midId < colourId)
+                start = mid + 1;
+            else
+                end = mid;
+        }
+
+        return ~start;
     }
 
     //==============================================================================
@@ -367,6 +383,224 @@ struct Component::ComponentHelpers
     }
 };
 
+//==============================================================================
+/*  Collects the areas passed to repaint() for lightweight components, so that each
+    component's dirty region only has to be walked up the hierarchy to its peer once
+    per paint, rather than once for every call to repaint().
+*/
+class Component::RepaintAccumulator  : private AsyncUpdater,
+                                       public DeletedAtShutdown
+{
+public:
+    RepaintAccumulator()
+    {
+        zerostruct (stats);
+    }
+
+    ~RepaintAccumulator()
+    {
+        clearSingletonInstance();
+    }
+
+    juce_DeclareSingleton_SingleThreaded_Minimal (RepaintAccumulator);
+
+    void addArea (Component& comp, const Rectangle<int>& area, const bool isEntireComponent)
+    {
+        ++stats.numRepaintRequests;
+
+        PendingArea* pending;
+
+        if (comp.flags.hasPendingRepaintFlag)
+        {
+            pending = pendingLookup [&comp];
+            jassert (pending != nullptr);
+        }
+        else
+        {
+            pending = new PendingArea (comp);
+            pendingAreas.add (pending);
+            pendingLookup.set (&comp, pending);
+            comp.flags.hasPendingRepaintFlag = true;
+            triggerAsyncUpdate();
+        }
+
+        // (for a whole-component repaint, the bounds are only read when it's dispatched,
+        // in case the component gets resized before then)
+        if (! pending->isEntireComponent)
+        {
+            if (isEntireComponent)
+            {
+                pending->isEntireComponent = true;
+                pending->area.clear();
+            }
+            else
+            {
+                pending->area.add (area);
+            }
+        }
+    }
+
+    void removeComponent (Component& comp)
+    {
+        PendingArea* const pending = pendingLookup [&comp];
+
+        if (pending != nullptr)
+        {
+            pending->component = nullptr;
+            pendingLookup.remove (&comp);
+        }
+
+        comp.flags.hasPendingRepaintFlag = false;
+    }
+
+    void dispatch()
+    {
+        if (pendingAreas.size() == 0)
+            return;
+
+        cancelPendingUpdate();
+        ++stats.numBatches;
+
+        // swap the list out first, in case anything gets repainted while we're dispatching..
+        OwnedArray<PendingArea> areas;
+        areas.swapWithArray (pendingAreas);
+        pendingLookup.clear();
+
+        for (int i = 0; i < areas.size(); ++i)
+        {
+            PendingArea* const pending = areas.getUnchecked (i);
+
+            if (pending->component != nullptr)
+            {
+                pending->component->flags.hasPendingRepaintFlag = false;
+                ++stats.numComponentsResolved;
+
+                if (pending->isEntireComponent)
+                    pending->area = pending->component->getLocalBounds();
+
+                sendToPeer (pending->component, pending->area);
+            }
+        }
+    }
+
+    /* The cached images have to be invalidated straight away rather than when the
+       repaint is dispatched, because someone might call paintEntireComponent() or
+       Drawable::draw() before that happens. Parents rarely have a cached image, so
+       this only converts the area into their space when one of them needs it.
+    */
+    static void invalidateParentCachedImages (Component& comp, const Rectangle<int>& area)
+    {
+        Component* lastParentWithCache = nullptr;
+
+        for (Component* c = &comp; c->flags.visibleFlag && ! c->flags.hasHeavyweightPeerFlag;)
+        {
+            c = c->parentComponent;
+
+            if (c == nullptr)
+                break;
+
+            if (c->cachedImage != nullptr)
+                lastParentWithCache = c;
+        }
+
+        if (lastParentWithCache != nullptr)
+        {
+            Rectangle<int> r (area);
+
+            for (Component* c = &comp; c != lastParentWithCache;)
+            {
+                r = ComponentHelpers::convertToParentSpace (*c, r);
+                c = c->parentComponent;
+                r = r.getIntersection (c->getLocalBounds());
+
+                if (r.isEmpty())
+                    return;
+
+                if (c->cachedImage != nullptr)
+                    c->cachedImage->invalidate (r);
+            }
+        }
+    }
+
+    RepaintStatistics stats;
+
+private:
+    struct PendingArea
+    {
+        PendingArea (Component& comp) noexcept  : component (&comp), isEntireComponent (false) {}
+
+        Component* component;
+        RectangleList area;
+        bool isEntireComponent;
+    };
+
+    struct PointerHash
+    {
+        static int generateHash (Component* const comp, const int upperLimit) noexcept
+        {
+            return (int) ((((pointer_sized_uint) comp) >> 4) % (pointer_sized_uint) upperLimit);
+        }
+    };
+
+    OwnedArray<PendingArea> pendingAreas;
+    HashMap<Component*, PendingArea*, PointerHash> pendingLookup;
+
+    void handleAsyncUpdate()
+    {
+        dispatch();
+    }
+
+    void sendToPeer (Component* comp, RectangleList& area)
+    {
+        // (any cached images along the way were already invalidated when repaint() was called)
+        while (comp->flags.visibleFlag)
+        {
+            if (comp->flags.hasHeavyweightPeerFlag)
+            {
+                ComponentPeer* const peer = comp->getPeer();
+
+                if (peer != nullptr)
+                {
+                    for (RectangleList::Iterator i (area); i.next();)
+                        peer->repaint (*i.getRectangle());
+
+                    stats.numRectanglesToPeers += area.getNumRectangles();
+                }
+
+                return;
+            }
+
+            Component* const parent = comp->parentComponent;
+
+            if (parent == nullptr)
+                return;
+
+            if (comp->affineTransform == nullptr)
+            {
+                area.offsetAll (comp->getX(), comp->getY());
+            }
+            else
+            {
+                RectangleList transformed;
+
+                for (RectangleList::Iterator i (area); i.next();)
+                    transformed.add (ComponentHelpers::convertToParentSpace (*comp, *i.getRectangle()));
+
+                area.swapWith (transformed);
+            }
+
+            if (! area.clipTo (parent->getLocalBounds()))
+                return;
+
+            comp = parent;
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (RepaintAccumulator);
+};
+
+juce_ImplementSingleton_SingleThreaded (Component::RepaintAccumulator)
+
 //==============================================================================
 Component::Component()
   : parentComponent (nullptr),
@@ -406,6 +640,14 @@ Component::~Component()
     if (flags.hasHeavyweightPeerFlag)
         removeFromDesktop();
 
+    if (flags.hasPendingRepaintFlag)
+    {
+        RepaintAccumulator* const accumulator = RepaintAccumulator::getInstanceWithoutCreating();
+
+        if (accumulator != nullptr)
+            accumulator->removeComponent (*this);
+    }
+
     // Something has added some children to this component during its destructor! Not a smart idea!
     jassert (childComponentList.size() == 0);
 }
@@ -1818,6 +2060,10 @@ void Component::internalRepaintUnchecked (const Rectangle<int>& area, const bool
 {
     if (flags.visibleFlag)
     {
+        // if component methods are being called from threads other than the message
+        // thread, you'll need to use a MessageManagerLock object to make sure it's thread-safe.
+        CHECK_MESSAGE_MANAGER_IS_LOCKED_OR_OFFSCREEN
+
         if (cachedImage != nullptr)
         {
             if (isEntireComponent)
@@ -1828,10 +2074,6 @@ void Component::internalRepaintUnchecked (const Rectangle<int>& area, const bool
 
         if (flags.hasHeavyweightPeerFlag)
         {
-            // if component methods are being called from threads other than the message
-            // thread, you'll need to use a MessageManagerLock object to make sure it's thread-safe.
-            CHECK_MESSAGE_MANAGER_IS_LOCKED
-
             ComponentPeer* const peer = getPeer();
 
             if (peer != nullptr)
@@ -1839,12 +2081,36 @@ void Component::internalRepaintUnchecked (const Rectangle<int>& area, const bool
         }
         else
         {
-            if (parentComponent != nullptr)
-                parentComponent->internalRepaint (ComponentHelpers::convertToParentSpace (*this, area));
+            RepaintAccumulator::invalidateParentCachedImages (*this, area);
+
+            // (an offscreen component may be getting painted on another thread, and has
+            // nowhere to send the repaint anyway, so it mustn't touch the accumulator)
+            if (getPeer() != nullptr)
+                RepaintAccumulator::getInstance()->addArea (*this, area, isEntireComponent);
         }
     }
 }
 
+void Component::dispatchPendingRepaints()
+{
+    RepaintAccumulator* const accumulator = RepaintAccumulator::getInstanceWithoutCreating();
+
+    if (accumulator != nullptr)
+        accumulator->dispatch();
+}
+
+Component::RepaintStatistics Component::getRepaintStatistics() noexcept
+{
+    RepaintAccumulator* const accumulator = RepaintAccumulator::getInstanceWithoutCreating();
+
+    if (accumulator != nullptr)
+        return accumulator->stats;
+
+    RepaintStatistics empty;
+    zerostruct (empty);
+    return empty;
+}
+
 //==============================================================================
 void Component::paint (Graphics&)
 {
@@ -1986,6 +2252,8 @@ void Component::setPaintingIsUnclipped (const bool shouldPaintWithoutClipping) n
 Image Component::createComponentSnapshot (const Rectangle<int>& areaToGrab,
                                           const bool clipImageToComponentBounds)
 {
+    dispatchPendingRepaints();
+
     Rectangle<int> r (areaToGrab);
 
     if (clipImageToComponentBounds)
@@ -2063,52 +2331,103 @@ void Component::sendLookAndFeelChange()
 
 Colour Component::findColour (const int colourId, const bool inheritFromParent) const
 {
-    const var* const v = properties.getVarPointer (ComponentHelpers::getColourPropertyId (colourId));
+    const Component* comp = this;
+
+    for (;;)
+    {
+        const int index = ComponentHelpers::findExplicitColour (*comp, colourId);
+
+        if (index >= 0)
+            return comp->explicitColours.getReference (index).colour;
 
-    if (v != nullptr)
-        return Colour ((uint32) static_cast <int> (*v));
+        if (! (inheritFromParent && comp->parentComponent != nullptr
+                && (comp->lookAndFeel == nullptr || ! comp->lookAndFeel->isColourSpecified (colourId))))
+            break;
 
-    if (inheritFromParent && parentComponent != nullptr
-         && (lookAndFeel == nullptr || ! lookAndFeel->isColourSpecified (colourId)))
-        return parentComponent->findColour (colourId, true);
+        comp = comp->parentComponent;
+    }
 
-    return getLookAndFeel().findColour (colourId);
+    return comp->getLookAndFeel().findColour (colourId);
 }
 
 bool Component::isColourSpecified (const int colourId) const
 {
-    return properties.contains (ComponentHelpers::getColourPropertyId (colourId));
+    return ComponentHelpers::findExplicitColour (*this, colourId) >= 0;
 }
 
 void Component::removeColour (const int colourId)
 {
-    if (properties.remove (ComponentHelpers::getColourPropertyId (colourId)))
+    const int index = ComponentHelpers::findExplicitColour (*this, colourId);
+
+    if (index >= 0)
+    {
+        explicitColours.remove (index);
         colourChanged();
+    }
 }
 
 void Component::setColour (const int colourId, const Colour& colour)
 {
-    if (properties.set (ComponentHelpers::getColourPropertyId (colourId), (int) colour.getARGB()))
-        colourChanged();
+    const int index = ComponentHelpers::findExplicitColour (*this, colourId);
+
+    if (index >= 0)
+    {
+        ExplicitColour& existing = explicitColours.getReference (index);
+
+        if (existing.colour == colour)
+            return;
+
+        existing.colour = colour;
+    }
+    else
+    {
+        const ExplicitColour newColour = { colourId, colour };
+        explicitColours.insert (~index, newColour);
+    }
+
+    colourChanged();
 }
 
 void Component::copyAllExplicitColoursTo (Component& target) const
 {
     bool changed = false;
 
-    for (int i = properties.size(); --i >= 0;)
+    for (int i = 0; i < explicitColours.size(); ++i)
     {
-        const Identifier name (properties.getName(i));
+        const ExplicitColour& c = explicitColours.getReference (i);
+        const int index = ComponentHelpers::findExplicitColour (target, c.colourId);
+
+        if (index >= 0)
+        {
+            ExplicitColour& existing = target.explicitColours.getReference (index);
 
-        if (name.toString().startsWith ("jcclr_"))
-            if (target.properties.set (name, properties [name]))
+            if (existing.colour != c.colour)
+            {
+                existing.colour = c.colour;
                 changed = true;
+            }
+        }
+        else
+        {
+            target.explicitColours.insert (~index, c);
+            changed = true;
+        }
     }
 
     if (changed)
         target.colourChanged();
 }
 
+Array<int> Component::getExplicitColourIds() const
+{
+    Array<int> ids;
+
+    for (int i = 0; i < explicitColours.size(); ++i)
+        ids.add (explicitColours.getReference (i).colourId);
+
+    return ids;
+}
+
 //==============================================================================
 MarkerList* Component::getMarkers (bool /*xAxis*/)
 {
@@ -1003,6 +1003,36 @@ public:
     */
     void repaint (const Rectangle<int>& area);
 
+    //==============================================================================
+    /** Immediately passes any repaint areas that are waiting to be delivered on to
+        their component peers.
+
+        Calls to repaint() on components that aren't on the desktop themselves are
+        collected, and each component's dirty region is only converted into window
+        coordinates once, just before the next paint. This happens automatically, but
+        you can call this method if you need the peers to know about all the dirty
+        areas right now, e.g. before calling ComponentPeer::performAnyPendingRepaintsNow()
+        (which calls it anyway).
+    */
+    static void dispatchPendingRepaints();
+
+    /** Some counters that show how much work the repaint batching has been doing.
+        @see getRepaintStatistics
+    */
+    struct RepaintStatistics
+    {
+        int64 numRepaintRequests;       /**< The number of areas that have been passed to repaint() for components that aren't on the desktop. */
+        int64 numComponentsResolved;    /**< The number of times a component's accumulated dirty region has been converted into window coordinates. */
+        int64 numRectanglesToPeers;     /**< The number of rectangles that have been passed on to component peers as a result. */
+        int64 numBatches;               /**< The number of times a set of pending repaints has been dispatched. */
+    };
+
+    /** Returns the running totals of the repaint counters since the app started.
+        Comparing numRepaintRequests with numComponentsResolved shows how many walks up the
+        component hierarchy have been saved by merging repaints together.
+    */
+    static RepaintStatistics getRepaintStatistics() noexcept;
+
     //==============================================================================
     /** Makes the component use an internal buffer to optimise its redrawing.
 
@@ -2089,6 +2119,12 @@ public:
     */
     void copyAllExplicitColoursTo (Component& target) const;
 
+    /** Returns the IDs of all the colours that have been set explicitly for this
+        component using the setColour() method.
+        @see setColour, isColourSpecified
+    */
+    Array<int> getExplicitColourIds() const;
+
     /** This method is called when a colour is changed by the setColour() method.
 
         @see setColour, findColour
@@ -2302,6 +2338,7 @@ private:
         bool isDisabledFlag             : 1;
         bool childCompFocusedFlag       : 1;
         bool dontClipGraphicsFlag       : 1;
+        bool hasPendingRepaintFlag      : 1;
       #if JUCE_DEBUG
         bool isInsidePaintCall          : 1;
       #endif
@@ -2347,8 +2384,18 @@ private:
     void sendEnablementChangeMessage();
     void sendVisibilityChangeMessage();
 
+    struct ExplicitColour
+    {
+        int colourId;
+        Colour colour;
+    };
+
+    Array <ExplicitColour> explicitColours;   // kept sorted by colourId
+
     struct ComponentHelpers;
     friend struct ComponentHelpers;
+    class RepaintAccumulator;
+    friend class RepaintAccumulator;
 
     /* Components aren't allowed to have copy constructors, as this would mess up parent hierarchies.
        You might need to give your subclasses a private dummy constructor to avoid compiler warnings.
@@ -212,6 +212,15 @@ public:
     */
     ComponentAnimator& getAnimator() noexcept                       { return animator; }
 
+    /** Returns the shared clock that should be used to drive animations.
+
+        Using this rather than a separate Timer for each animation means that they all get
+        updated together, once per frame, just before the windows are repainted.
+
+        @see AnimationClock
+    */
+    AnimationClock& getAnimationClock() noexcept                    { return animationClock; }
+
     //==============================================================================
     /** Returns the current default look-and-feel for components which don't have one
         explicitly set.
@@ -404,6 +413,7 @@ private:
 
     int allowedOrientations;
 
+    AnimationClock animationClock;
     ComponentAnimator animator;
 
     void timerCallback();
@@ -39,6 +39,61 @@ Drawable::~Drawable()
 {
 }
 
+//==============================================================================
+class DrawableRasterCache  : public CachedComponentImage
+{
+public:
+    DrawableRasterCache (Drawable& owner_) noexcept
+        : owner (owner_), cachedScale (0)
+    {
+    }
+
+    void paint (Graphics& g)
+    {
+        paintWithAlpha (g, owner.getAlpha());
+    }
+
+    // Drawable::draw() ignores the component's own alpha, as the uncached path does.
+    void paintWithAlpha (Graphics& g, const float alpha)
+    {
+        const float scale = g.getInternalContext()->getScaleFactor();
+        const Rectangle<int> bounds (owner.getLocalBounds());
+
+        if (image.isNull() || scale != cachedScale || bounds != cachedBounds)
+        {
+            cachedScale = scale;
+            cachedBounds = bounds;
+
+            image = Image (Image::ARGB,
+                           jmax (1, (int) std::ceil (bounds.getWidth() * scale)),
+                           jmax (1, (int) std::ceil (bounds.getHeight() * scale)), true);
+
+            Graphics imG (image);
+            imG.addTransform (AffineTransform::scale (scale, scale));
+            owner.paintEntireComponent (imG, true);
+        }
+
+        g.setColour (Colours::black.withAlpha (alpha));
+
+        if (scale == 1.0f)
+            g.drawImageAt (image, 0, 0);
+        else
+            g.drawImageTransformed (image, AffineTransform::scale (1.0f / scale, 1.0f / scale), false);
+    }
+
+    void invalidateAll()                            { image = Image::null; }
+    void invalidate (const Rectangle<int>&)         { image = Image::null; }
+    void releaseResources()                         { image = Image::null; }
+
+private:
+    Drawable& owner;
+    Image image;
+    Rectangle<int> cachedBounds;
+    float cachedScale;
+
+    JUCE_DECLARE_NON_COPYABLE (DrawableRasterCache);
+};
+
 //==============================================================================
 void Drawable::draw (Graphics& g, float opacity, const AffineTransform& transform) const
 {
@@ -56,15 +111,25 @@ void Drawable::nonConstDraw (Graphics& g, float opacity, const AffineTransform&
 
     if (! g.isClipEmpty())
     {
+        DrawableRasterCache* const cache = dynamic_cast <DrawableRasterCache*> (getCachedComponentImage());
+
         if (opacity < 1.0f)
         {
             g.beginTransparencyLayer (opacity);
-            paintEntireComponent (g, true);
+
+            if (cache != nullptr)
+                cache->paintWithAlpha (g, 1.0f);
+            else
+                paintEntireComponent (g, true);
+
             g.endTransparencyLayer();
         }
         else
         {
-            paintEntireComponent (g, true);
+            if (cache != nullptr)
+                cache->paintWithAlpha (g, 1.0f);
+            else
+                paintEntireComponent (g, true);
         }
     }
 }
@@ -79,6 +144,28 @@ void Drawable::drawWithin (Graphics& g, const Rectangle<float>& destArea, const
     draw (g, opacity, placement.getTransformToFit (getDrawableBounds(), destArea));
 }
 
+void Drawable::setRasterCachingEnabled (const bool shouldCacheImage)
+{
+    if (shouldCacheImage != isRasterCachingEnabled())
+        setCachedComponentImage (shouldCacheImage ? new DrawableRasterCache (*this) : nullptr);
+}
+
+bool Drawable::isRasterCachingEnabled() const noexcept
+{
+    return dynamic_cast <DrawableRasterCache*> (getCachedComponentImage()) != nullptr;
+}
+
+void Drawable::invalidateRasterCaches()
+{
+    for (Drawable* d = this; d != nullptr; d = d->getParent())
+    {
+        DrawableRasterCache* const cache = dynamic_cast <DrawableRasterCache*> (d->getCachedComponentImage());
+
+        if (cache != nullptr)
+            cache->invalidateAll();
+    }
+}
+
 //==============================================================================
 DrawableComposite* Drawable::getParent() const
 {
@@ -120,6 +207,75 @@ void Drawable::setTransformToFit (const Rectangle<float>& area, const RectangleP
         setTransform (placement.getTransformToFit (getDrawableBounds(), area));
 }
 
+//==============================================================================
+/*  Keeps the most recently parsed SVG documents, so that loading the same icon again
+    only costs a copy of the drawable tree rather than a full XML parse.
+*/
+class SVGDrawableCache  : public DeletedAtShutdown
+{
+public:
+    SVGDrawableCache() {}
+
+    ~SVGDrawableCache()
+    {
+        clearSingletonInstance();
+    }
+
+    Drawable* createCopyOf (const String& svgText)
+    {
+        const int64 hashCode = svgText.hashCode64();
+
+        const ScopedLock sl (lock);
+
+        for (int i = items.size(); --i >= 0;)
+        {
+            Item* const item = items.getUnchecked(i);
+
+            if (item->hashCode == hashCode && item->svgText == svgText)
+            {
+                items.move (i, -1); // keep the most recently used items at the end
+                return item->drawable->createCopy();
+            }
+        }
+
+        return nullptr;
+    }
+
+    void add (const String& svgText, const Drawable& drawable)
+    {
+        Item* const item = new Item();
+        item->hashCode = svgText.hashCode64();
+        item->svgText = svgText;
+        item->drawable = drawable.createCopy();
+
+        const ScopedLock sl (lock);
+
+        if (items.size() >= maxNumItems)
+            items.remove (0);
+
+        items.add (item);
+    }
+
+    juce_DeclareSingleton (SVGDrawableCache, false);
+
+private:
+    struct Item
+    {
+        int64 hashCode;
+        String svgText;
+        ScopedPointer<Drawable> drawable;
+    };
+
+    enum { maxNumItems = 64 };
+
+    OwnedArray<Item> items;
+    CriticalSection lock;
+
+    JUCE_DECLARE_NON_COPYABLE (SVGDrawableCache);
+};
+
+juce_ImplementSingleton (SVGDrawableCache);
+
 //==============================================================================
 Drawable* Drawable::createFromImageData (const void* data, const size_t numBytes)
 {
@@ -137,15 +293,25 @@ Drawable* Drawable::createFromImageData (const void* data, const size_t numBytes
     {
         const String asString (String::createStringFromData (data, (int) numBytes));
 
-        XmlDocument doc (asString);
-        ScopedPointer <XmlElement> outer (doc.getDocumentElement (true));
+        result = SVGDrawableCache::getInstance()->createCopyOf (asString);
 
-        if (outer != nullptr && outer->hasTagName ("svg"))
+        if (result == nullptr)
         {
-            ScopedPointer <XmlElement> svg (doc.getDocumentElement());
+            XmlDocument doc (asString);
+            ScopedPointer <XmlElement> outer (doc.getDocumentElement (true));
+
+            if (outer != nullptr && outer->hasTagName ("svg"))
+            {
+                ScopedPointer <XmlElement> svg (doc.getDocumentElement());
+
+                if (svg != nullptr)
+                {
+                    result = Drawable::createFromSVG (*svg);
 
-            if (svg != nullptr)
-                result = Drawable::createFromSVG (*svg);
+                    if (result != nullptr)
+                        SVGDrawableCache::getInstance()->add (asString, *result);
+                }
+            }
         }
     }
 
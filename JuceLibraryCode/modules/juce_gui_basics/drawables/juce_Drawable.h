@@ -123,6 +123,26 @@ public:
     /** Returns the DrawableComposite that contains this object, if there is one. */
     DrawableComposite* getParent() const;
 
+    //==============================================================================
+    /** Enables caching of this drawable's rendered appearance.
+
+        When this is turned on, the first time the drawable (and any children it has) is
+        drawn at a particular scale, it gets rendered into an image, and after that the
+        image is simply blitted until the scale changes or something in the drawable is
+        modified. This makes static icons far cheaper to draw, at the cost of the memory
+        for the image.
+
+        The cached image is drawn with whatever transform is in use, so if the drawable is
+        rotated or placed at a non-integer position, it may look slightly softer than it
+        would when rendered directly.
+
+        By default this is disabled.
+    */
+    void setRasterCachingEnabled (bool shouldCacheImage);
+
+    /** Returns true if setRasterCachingEnabled() has been used to turn on caching. */
+    bool isRasterCachingEnabled() const noexcept;
+
     //==============================================================================
     /** Tries to turn some kind of image file into a drawable.
 
@@ -213,6 +233,15 @@ protected:
     /** @internal */
     void setBoundsToEnclose (const Rectangle<float>&);
 
+    /** Throws away the cached image of this drawable and of any parents that have raster
+        caching enabled.
+
+        Subclasses call this whenever their appearance changes. Repainting isn't enough on its
+        own, because a drawable that's only used with draw() is never made visible, and
+        repaint() ignores invisible components.
+    */
+    void invalidateRasterCaches();
+
     Point<int> originRelativeToComponent;
 
   #ifndef DOXYGEN
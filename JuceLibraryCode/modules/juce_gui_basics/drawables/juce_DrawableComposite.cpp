@@ -25,7 +25,8 @@
 
 DrawableComposite::DrawableComposite()
     : bounds (Point<float>(), Point<float> (100.0f, 0.0f), Point<float> (0.0f, 100.0f)),
-      updateBoundsReentrant (false)
+      updateBoundsReentrant (false),
+      boundsFollowChildren (true)
 {
     setContentArea (RelativeRectangle (RelativeCoordinate (0.0),
                                        RelativeCoordinate (100.0),
@@ -38,8 +39,11 @@ DrawableComposite::DrawableComposite (const DrawableComposite& other)
       bounds (other.bounds),
       markersX (other.markersX),
       markersY (other.markersY),
-      updateBoundsReentrant (false)
+      updateBoundsReentrant (false),
+      boundsFollowChildren (true)
 {
+    setBoundsFollowChildren (false);
+
     for (int i = 0; i < other.getNumChildComponents(); ++i)
     {
         const Drawable* const d = dynamic_cast <const Drawable*> (other.getChildComponent(i));
@@ -47,6 +51,8 @@ DrawableComposite::DrawableComposite (const DrawableComposite& other)
         if (d != nullptr)
             addAndMakeVisible (d->createCopy());
     }
+
+    setBoundsFollowChildren (true);
 }
 
 DrawableComposite::~DrawableComposite()
@@ -172,16 +178,29 @@ void DrawableComposite::parentHierarchyChanged()
 void DrawableComposite::childBoundsChanged (Component*)
 {
     updateBoundsToFitChildren();
+    invalidateRasterCaches();
 }
 
 void DrawableComposite::childrenChanged()
 {
     updateBoundsToFitChildren();
+    invalidateRasterCaches();
+}
+
+void DrawableComposite::setBoundsFollowChildren (const bool shouldFollowChildren)
+{
+    if (boundsFollowChildren != shouldFollowChildren)
+    {
+        boundsFollowChildren = shouldFollowChildren;
+
+        if (shouldFollowChildren)
+            updateBoundsToFitChildren();
+    }
 }
 
 void DrawableComposite::updateBoundsToFitChildren()
 {
-    if (! updateBoundsReentrant)
+    if (boundsFollowChildren && ! updateBoundsReentrant)
     {
         const ScopedValueSetter<bool> setter (updateBoundsReentrant, true, false);
 
@@ -86,6 +86,15 @@ public:
     */
     void resetContentAreaAndBoundingBoxToFitChildren();
 
+    /** Changes whether the component's bounds are refitted around its children whenever one
+        of them is added, removed or moved.
+
+        This is on by default. Each refit has to look at all the children, so if you're adding a
+        large number of them, it's quicker to turn it off while doing so. Turning it back on
+        refits the bounds straight away.
+    */
+    void setBoundsFollowChildren (bool shouldFollowChildren);
+
     //==============================================================================
     /** The name of the marker that defines the left edge of the content area. */
     static const char* const contentLeftMarkerName;
@@ -146,7 +155,7 @@ private:
     //==============================================================================
     RelativeParallelogram bounds;
     MarkerList markersX, markersY;
-    bool updateBoundsReentrant;
+    bool updateBoundsReentrant, boundsFollowChildren;
 
     friend class Drawable::Positioner<DrawableComposite>;
     bool registerCoordinates (RelativeCoordinatePositionerBase&);
@@ -56,16 +56,19 @@ void DrawableImage::setImage (const Image& imageToUse)
     recalculateCoordinates (nullptr);
 
     repaint();
+    invalidateRasterCaches();
 }
 
 void DrawableImage::setOpacity (const float newOpacity)
 {
     opacity = newOpacity;
+    invalidateRasterCaches();
 }
 
 void DrawableImage::setOverlayColour (const Colour& newOverlayColour)
 {
     overlayColour = newOverlayColour;
+    invalidateRasterCaches();
 }
 
 void DrawableImage::setBoundingBox (const RelativeParallelogram& newBounds)
@@ -258,6 +261,7 @@ void DrawableImage::refreshFromValueTree (const ValueTree& tree, ComponentBuilde
          || overlayColour != newOverlayColour || image != newImage)
     {
         repaint();
+        invalidateRasterCaches();
         opacity = newOpacity;
         overlayColour = newOverlayColour;
 
@@ -66,7 +66,10 @@ public:
         ComponentScope scope (owner);
         if (isMainFill ? owner.mainFill.recalculateCoords (&scope)
                        : owner.strokeFill.recalculateCoords (&scope))
+        {
             owner.repaint();
+            owner.invalidateRasterCaches();
+        }
     }
 
     void applyNewBounds (const Rectangle<int>&)
@@ -111,6 +114,7 @@ void DrawableShape::setFillInternal (RelativeFillType& fill, const RelativeFillT
         }
 
         repaint();
+        invalidateRasterCaches();
     }
 }
 
@@ -183,6 +187,7 @@ void DrawableShape::strokeChanged()
 
     setBoundsToEnclose (getDrawableBounds());
     repaint();
+    invalidateRasterCaches();
 }
 
 Rectangle<float> DrawableShape::getDrawableBounds() const
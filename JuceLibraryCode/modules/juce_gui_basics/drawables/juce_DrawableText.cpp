@@ -65,6 +65,7 @@ void DrawableText::setColour (const Colour& newColour)
     {
         colour = newColour;
         repaint();
+        invalidateRasterCaches();
     }
 }
 
@@ -88,6 +89,7 @@ void DrawableText::setJustification (const Justification& newJustification)
 {
     justification = newJustification;
     repaint();
+    invalidateRasterCaches();
 }
 
 void DrawableText::setBoundingBox (const RelativeParallelogram& newBounds)
@@ -157,6 +159,7 @@ void DrawableText::recalculateCoordinates (Expression::Scope* scope)
 
     setBoundsToEnclose (getDrawableBounds());
     repaint();
+    invalidateRasterCaches();
 }
 
 const AffineTransform DrawableText::getArrangementAndTransform (GlyphArrangement& glyphs) const
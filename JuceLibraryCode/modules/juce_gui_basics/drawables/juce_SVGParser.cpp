@@ -29,6 +29,7 @@ public:
     //==============================================================================
     SVGState (const XmlElement* const topLevel)
         : topLevelXml (topLevel),
+          elements (new ElementTable (*topLevel)),
           elementX (0), elementY (0),
           width (512), height (512),
           viewBoxW (0), viewBoxH (0)
@@ -125,7 +126,137 @@ public:
 
 private:
     //==============================================================================
+    /* Holds the parent, id and split-up style list of every element in the document.
+       It's built in a single pass when parsing starts, so that looking up inherited
+       styles doesn't have to search the whole tree for each element's parent.
+    */
+    class ElementTable  : public ReferenceCountedObject
+    {
+    public:
+        ElementTable (const XmlElement& topLevel)
+        {
+            addElement (topLevel, nullptr);
+        }
+
+        const XmlElement* getParentOf (const XmlElement* const e) const
+        {
+            const ElementInfo* const info = infos [e];
+            return info != nullptr ? info->parent : nullptr;
+        }
+
+        const XmlElement* findElementForId (const String& id) const
+        {
+            return ids [id];
+        }
+
+        /** Returns the value of an entry in the element's style attribute, or an empty string. */
+        String getStyleValue (const XmlElement* const e, const String& name) const
+        {
+            const ElementInfo* const info = infos [e];
+
+            if (info != nullptr)
+            {
+                const int index = info->styleNames.indexOf (name);
+
+                if (index >= 0)
+                    return info->styleValues [index];
+            }
+
+            return String::empty;
+        }
+
+        bool hasStyleList (const XmlElement* const e) const
+        {
+            const ElementInfo* const info = infos [e];
+            return info != nullptr && info->hasStyle;
+        }
+
+    private:
+        struct ElementInfo
+        {
+            const XmlElement* parent;
+            StringArray styleNames, styleValues;
+            bool hasStyle;
+        };
+
+        struct PointerHashFunction
+        {
+            static int generateHash (const XmlElement* const key, const int upperLimit) noexcept
+            {
+                return (int) ((((pointer_sized_uint) key) >> 4) % (pointer_sized_uint) upperLimit);
+            }
+        };
+
+        OwnedArray<ElementInfo> infoStorage;
+        HashMap<const XmlElement*, ElementInfo*, PointerHashFunction> infos;
+        HashMap<String, const XmlElement*> ids;
+
+        void addElement (const XmlElement& e, const XmlElement* const parent)
+        {
+            ElementInfo* const info = new ElementInfo();
+            infoStorage.add (info);
+            info->parent = parent;
+            info->hasStyle = false;
+            infos.set (&e, info);
+
+            const String style (e.getStringAttribute ("style"));
+
+            if (style.isNotEmpty())
+            {
+                info->hasStyle = true;
+                splitStyleList (style, *info);
+            }
+
+            // if an id is repeated, the first element in document order wins
+            const String id (e.getStringAttribute ("id"));
+
+            if (id.isNotEmpty() && ! ids.contains (id))
+                ids.set (id, &e);
+
+            forEachXmlChildElement (e, child)
+                addElement (*child, &e);
+        }
+
+        static void splitStyleList (const String& style, ElementInfo& info)
+        {
+            String::CharPointerType s (style.getCharPointer());
+
+            while (! s.isEmpty())
+            {
+                const String::CharPointerType nameStart (s.findEndOfWhitespace());
+                String::CharPointerType colon (nameStart);
+
+                while (! (colon.isEmpty() || *colon == ':' || *colon == ';'))
+                    ++colon;
+
+                String::CharPointerType end (colon);
+
+                while (! (end.isEmpty() || *end == ';'))
+                    ++end;
+
+                if (*colon == ':')
+                {
+                    const String name (String (nameStart, colon).trimEnd());
+
+                    if (name.isNotEmpty() && ! info.styleNames.contains (name))
+                    {
+                        info.styleNames.add (name);
+                        info.styleValues.add (String (colon + 1, end).trim());
+                    }
+                }
+
+                s = end;
+
+                if (*s == ';')
+                    ++s;
+            }
+        }
+
+        JUCE_DECLARE_NON_COPYABLE (ElementTable);
+    };
+
     const XmlElement* const topLevelXml;
+    ReferenceCountedObjectPtr<ElementTable> elements;
     float elementX, elementY, width, height, viewBoxW, viewBoxH;
     AffineTransform transform;
     String cssStyleText;
@@ -133,6 +264,10 @@ private:
     //==============================================================================
     void parseSubElements (const XmlElement& xml, DrawableComposite* const parentDrawable)
     {
+        // Fitting the composite's bounds after every child would make large groups
+        // quadratic, so it's done just once, when they've all been added..
+        parentDrawable->setBoundsFollowChildren (false);
+
         forEachXmlChildElement (xml, e)
         {
             Drawable* d = nullptr;
@@ -152,6 +287,8 @@ private:
 
             parentDrawable->addAndMakeVisible (d);
         }
+
+        parentDrawable->setBoundsFollowChildren (true);
     }
 
     DrawableComposite* parseSwitch (const XmlElement& xml)
@@ -189,8 +326,8 @@ private:
     //==============================================================================
     Drawable* parsePath (const XmlElement& xml) const
     {
-        const String dAttribute (xml.getStringAttribute ("d").trimStart());
-        String::CharPointerType d (dAttribute.getCharPointer());
+        const String dAttribute (xml.getStringAttribute ("d"));
+        String::CharPointerType d (dAttribute.getCharPointer().findEndOfWhitespace());
         Path path;
 
         if (getStyleAttribute (&xml, "fill-rule").trim().equalsIgnoreCase ("evenodd"))
@@ -220,7 +357,7 @@ private:
             case 'm':
             case 'L':
             case 'l':
-                if (parseCoords (d, x, y, false))
+                if (parsePathCoords (d, x, y))
                 {
                     if (isRelative)
                     {
@@ -250,7 +387,7 @@ private:
 
             case 'H':
             case 'h':
-                if (parseCoord (d, x, false, true))
+                if (parseNextPathNumber (d, x))
                 {
                     if (isRelative)
                         x += lastX;
@@ -268,7 +405,7 @@ private:
 
             case 'V':
             case 'v':
-                if (parseCoord (d, y, false, false))
+                if (parseNextPathNumber (d, y))
                 {
                     if (isRelative)
                         y += lastY;
@@ -286,9 +423,9 @@ private:
 
             case 'C':
             case 'c':
-                if (parseCoords (d, x, y, false)
-                     && parseCoords (d, x2, y2, false)
-                     && parseCoords (d, x3, y3, false))
+                if (parsePathCoords (d, x, y)
+                     && parsePathCoords (d, x2, y2)
+                     && parsePathCoords (d, x3, y3))
                 {
                     if (isRelative)
                     {
@@ -315,8 +452,8 @@ private:
 
             case 'S':
             case 's':
-                if (parseCoords (d, x, y, false)
-                     && parseCoords (d, x3, y3, false))
+                if (parsePathCoords (d, x, y)
+                     && parsePathCoords (d, x3, y3))
                 {
                     if (isRelative)
                     {
@@ -343,8 +480,8 @@ private:
 
             case 'Q':
             case 'q':
-                if (parseCoords (d, x, y, false)
-                     && parseCoords (d, x2, y2, false))
+                if (parsePathCoords (d, x, y)
+                     && parsePathCoords (d, x2, y2))
                 {
                     if (isRelative)
                     {
@@ -369,7 +506,7 @@ private:
 
             case 'T':
             case 't':
-                if (parseCoords (d, x, y, false))
+                if (parsePathCoords (d, x, y))
                 {
                     if (isRelative)
                     {
@@ -394,23 +531,20 @@ private:
 
             case 'A':
             case 'a':
-                if (parseCoords (d, x, y, false))
+                if (parsePathCoords (d, x, y))
                 {
-                    String num;
+                    float angle;
+                    bool largeArc, sweep;
 
-                    if (parseNextNumber (d, num, false))
+                    if (parseNextPathNumber (d, angle))
                     {
-                        const float angle = num.getFloatValue() * (180.0f / float_Pi);
+                        angle *= (180.0f / float_Pi);
 
-                        if (parseNextNumber (d, num, false))
+                        if (parseNextPathFlag (d, largeArc))
                         {
-                            const bool largeArc = num.getIntValue() != 0;
-
-                            if (parseNextNumber (d, num, false))
+                            if (parseNextPathFlag (d, sweep))
                             {
-                                const bool sweep = num.getIntValue() != 0;
-
-                                if (parseCoords (d, x2, y2, false))
+                                if (parsePathCoords (d, x2, y2))
                                 {
                                     if (isRelative)
                                     {
@@ -635,7 +769,7 @@ private:
         if (! id.startsWithChar ('#'))
             return nullptr;
 
-        return findElementForId (topLevelXml, id.substring (1));
+        return elements->findElementForId (id.substring (1));
     }
 
     void addGradientStopsIn (ColourGradient& cg, const XmlElement* const fillXml) const
@@ -679,7 +813,7 @@ private:
             const String id (fill.fromFirstOccurrenceOf ("#", false, false)
                                  .upToLastOccurrenceOf (")", false, false).trim());
 
-            const XmlElement* const fillXml = findElementForId (topLevelXml, id);
+            const XmlElement* const fillXml = elements->findElementForId (id);
 
             if (fillXml != nullptr
                  && (fillXml->hasTagName ("linearGradient")
@@ -915,11 +1049,9 @@ private:
         if (xml->hasAttribute (attributeName))
             return xml->getStringAttribute (attributeName, defaultValue);
 
-        const String styleAtt (xml->getStringAttribute ("style"));
-
-        if (styleAtt.isNotEmpty())
+        if (elements->hasStyleList (xml))
         {
-            const String value (getAttributeFromStyleList (styleAtt, attributeName, String::empty));
+            const String value (elements->getStyleValue (xml, attributeName));
 
             if (value.isNotEmpty())
                 return value;
@@ -952,7 +1084,7 @@ private:
             }
         }
 
-        xml = const_cast <XmlElement*> (topLevelXml)->findParentElementOf (xml);
+        xml = elements->getParentOf (xml);
 
         if (xml != nullptr)
             return getStyleAttribute (xml, attributeName, defaultValue);
@@ -965,7 +1097,7 @@ private:
         if (xml->hasAttribute (attributeName))
             return xml->getStringAttribute (attributeName);
 
-        xml = const_cast <XmlElement*> (topLevelXml)->findParentElementOf (xml);
+        xml = elements->getParentOf (xml);
 
         if (xml != nullptr)
             return getInheritedAttribute  (xml, attributeName);
@@ -1066,6 +1198,112 @@ private:
         return true;
     }
 
+    //==============================================================================
+    /* The path data parsers below read numbers straight into floats rather than going
+       via a String, as path data often makes up most of the size of a large document.
+       They follow the SVG grammar, so a sign or a second decimal point starts a new
+       number, and arc flags can be packed together without separators.
+    */
+    static void skipPathSeparators (String::CharPointerType& s) noexcept
+    {
+        while (s.isWhitespace() || *s == ',')
+            ++s;
+    }
+
+    static bool parseNextPathNumber (String::CharPointerType& s, float& value) noexcept
+    {
+        skipPathSeparators (s);
+
+        String::CharPointerType p (s);
+        const bool isNegative = (*p == '-');
+
+        if (isNegative || *p == '+')
+            ++p;
+
+        double mantissa = 0;
+        int exponent = 0, numDigits = 0;
+
+        while (p.isDigit())
+        {
+            mantissa = mantissa * 10.0 + (int) (p.getAndAdvance() - '0');
+            ++numDigits;
+        }
+
+        if (*p == '.')
+        {
+            ++p;
+
+            while (p.isDigit())
+            {
+                mantissa = mantissa * 10.0 + (int) (p.getAndAdvance() - '0');
+                ++numDigits;
+                --exponent;
+            }
+        }
+
+        if (numDigits == 0)
+            return false;
+
+        if (*p == 'e' || *p == 'E')
+        {
+            String::CharPointerType e (p + 1);
+            const bool isNegativeExponent = (*e == '-');
+
+            if (isNegativeExponent || *e == '+')
+                ++e;
+
+            if (e.isDigit())
+            {
+                int exponentValue = 0;
+
+                while (e.isDigit())
+                    exponentValue = jmin (exponentValue * 10 + (int) (e.getAndAdvance() - '0'), 1000);
+
+                exponent += isNegativeExponent ? -exponentValue : exponentValue;
+                p = e;
+            }
+        }
+
+        if (exponent != 0)
+        {
+            static const double powersOfTen[] = { 1.0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7,
+                                                  1.0e8, 1.0e9, 1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15 };
+
+            if (exponent < 0 && exponent > -numElementsInArray (powersOfTen))
+                mantissa /= powersOfTen [-exponent];
+            else if (exponent > 0 && exponent < numElementsInArray (powersOfTen))
+                mantissa *= powersOfTen [exponent];
+            else
+                mantissa *= pow (10.0, (double) exponent);
+        }
+
+        value = (float) (isNegative ? -mantissa : mantissa);
+        s = p;
+        skipPathSeparators (s);
+        return true;
+    }
+
+    static bool parsePathCoords (String::CharPointerType& s, float& x, float& y) noexcept
+    {
+        return parseNextPathNumber (s, x)
+            && parseNextPathNumber (s, y);
+    }
+
+    static bool parseNextPathFlag (String::CharPointerType& s, bool& flag) noexcept
+    {
+        skipPathSeparators (s);
+
+        const juce_wchar c = *s;
+
+        if (c != '0' && c != '1')
+            return false;
+
+        flag = (c == '1');
+        ++s;
+        skipPathSeparators (s);
+        return true;
+    }
+
     //==============================================================================
     static Colour parseColour (const String& s, int& index, const Colour& defaultColour)
     {
@@ -1268,29 +1506,192 @@ private:
         deltaAngle = fmod (deltaAngle, double_Pi * 2.0);
     }
 
-    static const XmlElement* findElementForId (const XmlElement* const parent, const String& id)
+    SVGState& operator= (const SVGState&);
+};
+
+
+//==============================================================================
+Drawable* Drawable::createFromSVG (const XmlElement& svgDocument)
+{
+    SVGState state (&svgDocument);
+    return state.parseSVGElement (svgDocument);
+}
+
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SVGParserTests  : public UnitTest
+{
+public:
+    SVGParserTests() : UnitTest ("SVG parser") {}
+
+    static Drawable* parseDocument (const String& svgText)
+    {
+        XmlDocument doc (svgText);
+        ScopedPointer<XmlElement> svg (doc.getDocumentElement());
+        return svg != nullptr ? Drawable::createFromSVG (*svg) : nullptr;
+    }
+
+    static Path parsePathData (const String& pathData)
+    {
+        ScopedPointer<Drawable> drawable (parseDocument ("<svg><path d=\"" + pathData + "\"/></svg>"));
+
+        if (drawable != nullptr)
+        {
+            const DrawablePath* const dp = dynamic_cast <const DrawablePath*> (drawable->getChildComponent (0));
+
+            if (dp != nullptr)
+                return dp->getPath();
+        }
+
+        return Path();
+    }
+
+    static bool pathsMatch (const Path& p1, const Path& p2)
     {
-        forEachXmlChildElement (*parent, e)
+        Path::Iterator i1 (p1), i2 (p2);
+
+        for (;;)
         {
-            if (e->compareAttribute ("id", id))
-                return e;
+            const bool hasNext1 = i1.next();
+
+            if (hasNext1 != i2.next())
+                return false;
 
-            const XmlElement* const found = findElementForId (e, id);
+            if (! hasNext1)
+                return true;
 
-            if (found != nullptr)
-                return found;
+            if (i1.elementType != i2.elementType)
+                return false;
+
+            // (only the coordinates that this type of element uses are valid)
+            const int numPoints = i1.elementType == Path::Iterator::cubicTo ? 3
+                                    : (i1.elementType == Path::Iterator::quadraticTo ? 2
+                                        : (i1.elementType == Path::Iterator::closePath ? 0 : 1));
+
+            if ((numPoints > 0 && ! pointsMatch (i1.x1, i1.y1, i2.x1, i2.y1))
+                 || (numPoints > 1 && ! pointsMatch (i1.x2, i1.y2, i2.x2, i2.y2))
+                 || (numPoints > 2 && ! pointsMatch (i1.x3, i1.y3, i2.x3, i2.y3)))
+                return false;
         }
+    }
 
-        return nullptr;
+    static bool pointsMatch (const float x1, const float y1, const float x2, const float y2) noexcept
+    {
+        return std::abs (x1 - x2) <= 1.0e-4f && std::abs (y1 - y2) <= 1.0e-4f;
     }
 
-    SVGState& operator= (const SVGState&);
+    void checkPathData (const String& pathData, const Path& expected)
+    {
+        expect (pathsMatch (parsePathData (pathData), expected), "Wrong result for \"" + pathData + "\"");
+    }
+
+    static String createLargeDocument (Random& r, const int numGroups, const int numSegments)
+    {
+        String svg ("<svg width=\"1000\" height=\"1000\">");
+
+        for (int g = 0; g < numGroups; ++g)
+        {
+            svg << "<g id=\"group" << g << "\" style=\"fill:#" << String::toHexString (r.nextInt (0xffffff)).paddedLeft ('0', 6)
+                << ";stroke:none\"><path d=\"M" << r.nextInt (1000) << ',' << r.nextInt (1000);
+
+            for (int i = 0; i < numSegments; ++i)
+            {
+                if ((i & 3) == 0)
+                    svg << 'c' << (r.nextFloat() - 0.5f) * 20.0f << ',' << (r.nextFloat() - 0.5f) * 20.0f
+                        << ' ' << (r.nextFloat() - 0.5f) * 20.0f << ',' << (r.nextFloat() - 0.5f) * 20.0f
+                        << ' ' << (r.nextFloat() - 0.5f) * 20.0f << ',' << (r.nextFloat() - 0.5f) * 20.0f;
+                else
+                    svg << 'l' << (r.nextFloat() - 0.5f) * 20.0f << ',' << (r.nextFloat() - 0.5f) * 20.0f;
+            }
+
+            svg << "z\"/></g>";
+        }
+
+        return svg + "</svg>";
+    }
+
+    void runTest()
+    {
+        beginTest ("Path number syntax");
+
+        {
+            Path expected;
+            expected.startNewSubPath (1.5f, 0.5f);
+            expected.lineTo (-2.0f, -30.0f);
+            expected.lineTo (0.425f, 0.5f);
+            expected.lineTo (1.0e3f, -0.001f);
+
+            checkPathData ("M1.5.5L-2-3e1 4.25e-1.5+1E+3-1e-3", expected);
+            checkPathData ("  M 1.5 , 0.5 L -2 , -30 , 0.425 0.5 , 1000,-.001 ", expected);
+        }
+
+        beginTest ("Relative commands and implicit line-tos");
+
+        {
+            Path expected;
+            expected.startNewSubPath (10.0f, 20.0f);
+            expected.lineTo (40.0f, 60.0f);
+            expected.lineTo (35.0f, 60.0f);
+            expected.lineTo (35.0f, 65.0f);
+            expected.closeSubPath();
+
+            checkPathData ("m10,20 30,40h-5v5z", expected);
+            checkPathData ("M10 20L40 60H35V65Z", expected);
+        }
+
+        beginTest ("Curves");
+
+        {
+            Path expected;
+            expected.startNewSubPath (0.0f, 0.0f);
+            expected.cubicTo (1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f);
+            expected.cubicTo (7.0f, 8.0f, 7.0f, 8.0f, 9.0f, 10.0f);
+            expected.quadraticTo (11.0f, 12.0f, 13.0f, 14.0f);
+            expected.quadraticTo (15.0f, 16.0f, 17.0f, 18.0f);
+
+            checkPathData ("M0,0C1,2,3,4,5,6S7,8,9,10Q11,12,13,14T17,18", expected);
+            checkPathData ("M0 0c1 2 3 4 5 6s2 2 4 4q2 2 4 4t4 4", expected);
+        }
+
+        beginTest ("Packed arc flags");
+
+        {
+            const Path expected (parsePathData ("M0 0 A 10 10 0 1 0 10 10 a 5 5 0 0 1 5 5"));
+            expect (! expected.isEmpty());
+
+            checkPathData ("M0 0A10 10 0 1010 10a5 5 0 015 5", expected);
+            checkPathData ("M0,0A10,10,0,1,0,10,10a5,5,0,0,1,5,5", expected);
+        }
+
+        beginTest ("Parsing a large document");
+
+        {
+            Random r (1234);
+            const int numGroups = 300, numSegments = 200;
+            const String svg (createLargeDocument (r, numGroups, numSegments));
+
+            for (int run = 0; run < 3; ++run)
+            {
+                const double startTime = Time::getMillisecondCounterHiRes();
+                XmlDocument doc (svg);
+                ScopedPointer<XmlElement> xml (doc.getDocumentElement());
+                const double xmlTime = Time::getMillisecondCounterHiRes();
+
+                ScopedPointer<Drawable> drawable (Drawable::createFromSVG (*xml));
+                const double endTime = Time::getMillisecondCounterHiRes();
+
+                expect (drawable != nullptr && drawable->getNumChildComponents() == numGroups);
+                expect (drawable != nullptr && ! drawable->getDrawableBounds().isEmpty());
+
+                logMessage (String (svg.length() / 1024) + "KB document: XML parsed in " + String (xmlTime - startTime, 1)
+                              + "ms, drawables built in " + String (endTime - xmlTime, 1) + "ms");
+            }
+        }
+    }
 };
 
+static SVGParserTests svgParserTests;
 
-//==============================================================================
-Drawable* Drawable::createFromSVG (const XmlElement& svgDocument)
-{
-    SVGState state (&svgDocument);
-    return state.parseSVGElement (svgDocument);
-}
+#endif
@@ -98,7 +98,12 @@ void DirectoryContentsList::clear()
 
     if (files.size() > 0)
     {
-        files.clear();
+        {
+            const ScopedLock sl (fileListLock);
+            files.clear();
+            fileNames.clear();
+        }
+
         changed();
     }
 }
@@ -125,10 +130,21 @@ bool DirectoryContentsList::getFileInfo (const int index,
                                          FileInfo& result) const
 {
     const ScopedLock sl (fileListLock);
-    const FileInfo* const info = files [index];
+    CachedFileInfo* const info = files [index];
 
     if (info != nullptr)
     {
+        if (info->needsDetails)
+        {
+            const File file (root.getChildFile (info->filename));
+
+            info->fileSize = file.getSize();
+            info->modificationTime = file.getLastModificationTime();
+            info->creationTime = file.getCreationTime();
+            info->isReadOnly = ! file.hasWriteAccess();
+            info->needsDetails = false;
+        }
+
         result = *info;
         return true;
     }
@@ -151,11 +167,8 @@ bool DirectoryContentsList::contains (const File& targetFile) const
 {
     const ScopedLock sl (fileListLock);
 
-    for (int i = files.size(); --i >= 0;)
-        if (root.getChildFile (files.getUnchecked(i)->filename) == targetFile)
-            return true;
-
-    return false;
+    return targetFile.getParentDirectory() == root
+            && fileNames.contains (targetFile.getFileName());
 }
 
 bool DirectoryContentsList::isStillLoading() const
@@ -171,52 +184,65 @@ void DirectoryContentsList::changed()
 //==============================================================================
 int DirectoryContentsList::useTimeSlice()
 {
+    if (fileFindHandle == nullptr)
+        return 500;
+
     const uint32 startTime = Time::getApproximateMillisecondCounter();
-    bool hasChanged = false;
+    OwnedArray <CachedFileInfo> batch;
+    bool isFinished = false;
 
-    for (int i = 100; --i >= 0;)
+    for (;;)
     {
-        if (! checkNextFile (hasChanged))
+        if (! checkNextFile (batch))
         {
-            if (hasChanged)
-                changed();
-
-            return 500;
+            isFinished = true;
+            break;
         }
 
-        if (shouldStop || (Time::getApproximateMillisecondCounter() > startTime + 150))
+        if (shouldStop || (Time::getApproximateMillisecondCounter() > startTime + 50))
             break;
     }
 
-    if (hasChanged)
+    const bool hasChanged = addFiles (batch);
+
+    if (isFinished)
+        fileFindHandle = nullptr;
+
+    if (hasChanged || isFinished)
         changed();
 
-    return 0;
+    return isFinished ? 500 : 0;
 }
 
-bool DirectoryContentsList::checkNextFile (bool& hasChanged)
+bool DirectoryContentsList::checkNextFile (OwnedArray <CachedFileInfo>& batch)
 {
     if (fileFindHandle != nullptr)
     {
-        bool fileFoundIsDir, isHidden, isReadOnly;
-        int64 fileSize;
-        Time modTime, creationTime;
+        // Only ask for the directory flag here - the other details are expensive to
+        // get for every file, so they're fetched lazily by getFileInfo()
+        bool fileFoundIsDir;
 
-        if (fileFindHandle->next (&fileFoundIsDir, &isHidden, &fileSize,
-                                  &modTime, &creationTime, &isReadOnly))
+        if (fileFindHandle->next (&fileFoundIsDir, nullptr, nullptr, nullptr, nullptr, nullptr))
         {
-            if (addFile (fileFindHandle->getFile(), fileFoundIsDir,
-                         fileSize, modTime, creationTime, isReadOnly))
+            const File& file = fileFindHandle->getFile();
+
+            if (fileFilter == nullptr
+                 || ((! fileFoundIsDir) && fileFilter->isFileSuitable (file))
+                 || (fileFoundIsDir && fileFilter->isDirectorySuitable (file)))
             {
-                hasChanged = true;
+                CachedFileInfo* const info = new CachedFileInfo();
+
+                info->filename = file.getFileName();
+                info->fileSize = 0;
+                info->isDirectory = fileFoundIsDir;
+                info->isReadOnly = false;
+                info->needsDetails = true;
+
+                batch.add (info);
             }
 
             return true;
         }
-        else
-        {
-            fileFindHandle = nullptr;
-        }
     }
 
     return false;
@@ -233,35 +259,58 @@ int DirectoryContentsList::compareElements (const DirectoryContentsList::FileInf
     return first->filename.compareIgnoreCase (second->filename);
 }
 
-bool DirectoryContentsList::addFile (const File& file,
-                                     const bool isDir,
-                                     const int64 fileSize,
-                                     const Time& modTime,
-                                     const Time& creationTime,
-                                     const bool isReadOnly)
+bool DirectoryContentsList::addFiles (OwnedArray <CachedFileInfo>& batch)
 {
-    if (fileFilter == nullptr
-         || ((! isDir) && fileFilter->isFileSuitable (file))
-         || (isDir && fileFilter->isDirectorySuitable (file)))
+    if (batch.size() == 0)
+        return false;
+
+    batch.sort (*this);
+
+    const ScopedLock sl (fileListLock);
+
+    OwnedArray <CachedFileInfo> newFiles;
+    newFiles.ensureStorageAllocated (batch.size());
+
+    for (int i = 0; i < batch.size(); ++i)
     {
-        ScopedPointer <FileInfo> info (new FileInfo());
+        CachedFileInfo* const info = batch.getUnchecked (i);
+
+        if (fileNames.contains (info->filename))
+        {
+            delete info;
+        }
+        else
+        {
+            fileNames.set (info->filename, true);
+            newFiles.add (info);
+        }
+    }
 
-        info->filename = file.getFileName();
-        info->fileSize = fileSize;
-        info->modificationTime = modTime;
-        info->creationTime = creationTime;
-        info->isDirectory = isDir;
-        info->isReadOnly = isReadOnly;
+    batch.clear (false);
 
-        const ScopedLock sl (fileListLock);
+    if (newFiles.size() == 0)
+        return false;
 
-        for (int i = files.size(); --i >= 0;)
-            if (files.getUnchecked(i)->filename == info->filename)
-                return false;
+    // merge the sorted batch into the sorted list in one pass, rather than doing
+    // a separate sorted insert for each file
+    OwnedArray <CachedFileInfo> merged;
+    merged.ensureStorageAllocated (files.size() + newFiles.size());
 
-        files.addSorted (*this, info.release());
-        return true;
+    int oldIndex = 0, newIndex = 0;
+
+    while (oldIndex < files.size() && newIndex < newFiles.size())
+    {
+        if (compareElements (newFiles.getUnchecked (newIndex), files.getUnchecked (oldIndex)) < 0)
+            merged.add (newFiles.getUnchecked (newIndex++));
+        else
+            merged.add (files.getUnchecked (oldIndex++));
     }
 
-    return false;
+    while (oldIndex < files.size())       merged.add (files.getUnchecked (oldIndex++));
+    while (newIndex < newFiles.size())    merged.add (newFiles.getUnchecked (newIndex++));
+
+    files.clear (false);
+    newFiles.clear (false);
+    files.swapWithArray (merged);
+    return true;
 }
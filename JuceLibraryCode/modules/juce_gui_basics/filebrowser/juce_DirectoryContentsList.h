@@ -34,8 +34,14 @@
     A class to asynchronously scan for details about the files in a directory.
 
     This keeps a list of files and some information about them, using a background
-    thread to scan for more files. As files are found, it broadcasts change messages
-    to tell any listeners.
+    thread to scan for more files. As files are found, they're gathered into batches
+    and merged into the list, and a change message is broadcast after each batch to
+    tell any listeners.
+
+    To keep very large directories quick to scan, the size, time and read-only details
+    of each file are only fetched the first time that getFileInfo() is called for it,
+    so a list component that only asks about its visible rows won't have to stat every
+    file in the folder.
 
     @see FileListComponent, FileBrowserComponent
 */
@@ -158,6 +164,9 @@ public:
         If the index is in-range, this will return true and will copy the file's details
         to the structure that is passed-in.
 
+        The first time this is called for a particular file, its size, times and
+        read-only status will be read from the file system and cached.
+
         If it returns false, then the index wasn't in range, and the structure won't
         be affected.
 
@@ -192,23 +201,27 @@ public:
                                 const DirectoryContentsList::FileInfo* second);
 
 private:
+    struct CachedFileInfo  : public FileInfo
+    {
+        bool needsDetails;
+    };
+
     File root;
     const FileFilter* fileFilter;
     TimeSliceThread& thread;
     int fileTypeFlags;
 
     CriticalSection fileListLock;
-    OwnedArray <FileInfo> files;
+    OwnedArray <CachedFileInfo> files;
+    HashMap <String, bool> fileNames;
 
     ScopedPointer <DirectoryIterator> fileFindHandle;
     bool volatile shouldStop;
 
     void stopSearching();
     void changed();
-    bool checkNextFile (bool& hasChanged);
-    bool addFile (const File& file, bool isDir,
-                  const int64 fileSize, const Time& modTime,
-                  const Time& creationTime, bool isReadOnly);
+    bool checkNextFile (OwnedArray <CachedFileInfo>& batch);
+    bool addFiles (OwnedArray <CachedFileInfo>& batch);
     void setTypeFlags (int newFlags);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DirectoryContentsList);
@@ -177,6 +177,7 @@ namespace juce
 #include "filebrowser/juce_FileTreeComponent.cpp"
 #include "filebrowser/juce_ImagePreviewComponent.cpp"
 #include "filebrowser/juce_WildcardFileFilter.cpp"
+#include "layout/juce_AnimationClock.cpp"
 #include "layout/juce_ComponentAnimator.cpp"
 #include "layout/juce_ComponentBoundsConstrainer.cpp"
 #include "layout/juce_ComponentBuilder.cpp"
@@ -238,6 +238,9 @@ namespace juce
 #ifndef __JUCE_WILDCARDFILEFILTER_JUCEHEADER__
  #include "filebrowser/juce_WildcardFileFilter.h"
 #endif
+#ifndef __JUCE_ANIMATIONCLOCK_JUCEHEADER__
+ #include "layout/juce_AnimationClock.h"
+#endif
 #ifndef __JUCE_COMPONENTANIMATOR_JUCEHEADER__
  #include "layout/juce_ComponentAnimator.h"
 #endif
@@ -39,14 +39,15 @@ void CaretComponent::paint (Graphics& g)
     g.fillAll (findColour (caretColourId, true));
 }
 
-void CaretComponent::timerCallback()
+int CaretComponent::animationFrame (double)
 {
     setVisible (shouldBeShown() && ! isVisible());
+    return caretBlinkInterval;
 }
 
 void CaretComponent::setCaretPosition (const Rectangle<int>& characterArea)
 {
-    startTimer (380);
+    Desktop::getInstance().getAnimationClock().addListener (this, caretBlinkInterval);
     setVisible (shouldBeShown());
     setBounds (characterArea.withWidth (2));
 }
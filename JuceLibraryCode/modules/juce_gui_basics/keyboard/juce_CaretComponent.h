@@ -27,13 +27,14 @@
 #define __JUCE_CARETCOMPONENT_JUCEHEADER__
 
 #include "../components/juce_Component.h"
+#include "../layout/juce_AnimationClock.h"
 
 
 //==============================================================================
 /**
 */
 class JUCE_API  CaretComponent   : public Component,
-                                   public Timer
+                                   public AnimationClock::Listener
 {
 public:
     //==============================================================================
@@ -70,10 +71,12 @@ public:
     /** @internal */
     void paint (Graphics& g);
     /** @internal */
-    void timerCallback();
+    int animationFrame (double frameTime);
 
 private:
     Component* owner;
+    enum { caretBlinkInterval = 380 };
+
     bool shouldBeShown() const;
 
     JUCE_DECLARE_NON_COPYABLE (CaretComponent);
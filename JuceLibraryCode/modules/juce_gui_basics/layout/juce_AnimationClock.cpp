@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library - "Jules' Utility Class Extensions"
+   Copyright 2004-11 by Raw Material Software Ltd.
+
+  ------------------------------------------------------------------------------
+
+   JUCE can be redistributed and/or modified under the terms of the GNU General
+   Public License (Version 2), as published by the Free Software Foundation.
+   A copy of the license is included in the JUCE distribution, or can be found
+   online at www.gnu.org/licenses.
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+  ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.rawmaterialsoftware.com/juce for more information.
+
+  ==============================================================================
+*/
+
+AnimationClock::Listener::Listener() noexcept
+    : clock (nullptr),
+      nextFrameTime (0)
+{
+}
+
+AnimationClock::Listener::~Listener()
+{
+    if (clock != nullptr)
+        clock->removeListener (this);
+}
+
+//==============================================================================
+AnimationClock::AnimationClock()
+    : frameTime (Time::getMillisecondCounterHiRes()),
+      nextTimerCallbackTime (0),
+      framesPerSecond (60)
+{
+}
+
+AnimationClock::~AnimationClock()
+{
+    for (int i = listeners.size(); --i >= 0;)
+        listeners.getUnchecked(i)->clock = nullptr;
+}
+
+//==============================================================================
+void AnimationClock::addListener (Listener* const listener, const int millisecondsBeforeFirstFrame)
+{
+    jassert (listener != nullptr);
+
+    if (listener->clock != this)
+    {
+        // a listener can only be registered with one clock at a time!
+        jassert (listener->clock == nullptr);
+
+        listener->clock = this;
+        listeners.add (listener);
+    }
+
+    listener->nextFrameTime = Time::getMillisecondCounterHiRes() + jmax (0, millisecondsBeforeFirstFrame);
+
+    if (listener->nextFrameTime < nextTimerCallbackTime || ! isTimerRunning())
+        rescheduleTimer();
+}
+
+void AnimationClock::removeListener (Listener* const listener)
+{
+    if (listener != nullptr && listener->clock == this)
+    {
+        listener->clock = nullptr;
+        listeners.removeValue (listener);
+
+        if (listeners.size() == 0)
+            stopTimer();
+    }
+}
+
+bool AnimationClock::containsListener (Listener* const listener) const noexcept
+{
+    return listener != nullptr && listener->clock == this;
+}
+
+double AnimationClock::getProgress (const double animationStartTime, const double durationMilliseconds) const noexcept
+{
+    if (durationMilliseconds <= 0)
+        return 1.0;
+
+    return jlimit (0.0, 1.0, (frameTime - animationStartTime) / durationMilliseconds);
+}
+
+void AnimationClock::setFrameRate (const int newFramesPerSecond)
+{
+    jassert (newFramesPerSecond > 0);
+    framesPerSecond = jmax (1, newFramesPerSecond);
+    rescheduleTimer();
+}
+
+//==============================================================================
+void AnimationClock::timerCallback()
+{
+    frameTime = Time::getMillisecondCounterHiRes();
+
+    // anything due within half a frame gets called now, rather than waiting a whole frame for it
+    const double frameLength = 1000.0 / framesPerSecond;
+    const double cutOff = frameTime + frameLength * 0.5;
+    bool anyAnimating = false;
+
+    // (iterate a copy of the list, as listeners may add or remove others in their callbacks)
+    const Array <Listener*> listenersToCall (listeners);
+
+    for (int i = 0; i < listenersToCall.size(); ++i)
+    {
+        Listener* const l = listenersToCall.getUnchecked (i);
+
+        if (listeners.contains (l) && l->nextFrameTime <= cutOff)
+        {
+            const int msToWait = l->animationFrame (frameTime);
+
+            // (a listener that wants the next frame, or has just finished, is a moving animation,
+            // whereas something like a blinking caret can wait for the normal repaint timer)
+            if (msToWait < frameLength)
+                anyAnimating = true;
+
+            if (msToWait < 0)
+                removeListener (l);
+            else if (l->clock == this)
+                l->nextFrameTime = frameTime + msToWait;
+        }
+    }
+
+    // Paint whatever the animations have just changed straight away, so that all the
+    // movement in this frame appears at the same moment..
+    if (anyAnimating)
+        for (int i = ComponentPeer::getNumPeers(); --i >= 0;)
+            ComponentPeer::getPeer (i)->performAnyPendingRepaintsNow();
+
+    rescheduleTimer();
+}
+
+void AnimationClock::rescheduleTimer()
+{
+    if (listeners.size() == 0)
+    {
+        stopTimer();
+        return;
+    }
+
+    double nextDue = listeners.getUnchecked(0)->nextFrameTime;
+
+    for (int i = listeners.size(); --i > 0;)
+        nextDue = jmin (nextDue, listeners.getUnchecked(i)->nextFrameTime);
+
+    // keep the callbacks on whole frames, so that listeners with different
+    // intervals still end up being called together
+    const double frameLength = 1000.0 / framesPerSecond;
+    const double delay = jmax (0.0, nextDue - Time::getMillisecondCounterHiRes());
+    const int numFrames = jmax (1, (int) std::ceil (delay / frameLength));
+
+    const int msToWait = jmax (1, roundToInt (numFrames * frameLength));
+    nextTimerCallbackTime = Time::getMillisecondCounterHiRes() + msToWait;
+    startTimer (msToWait);
+}
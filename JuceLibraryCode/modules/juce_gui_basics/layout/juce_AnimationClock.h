@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library - "Jules' Utility Class Extensions"
+   Copyright 2004-11 by Raw Material Software Ltd.
+
+  ------------------------------------------------------------------------------
+
+   JUCE can be redistributed and/or modified under the terms of the GNU General
+   Public License (Version 2), as published by the Free Software Foundation.
+   A copy of the license is included in the JUCE distribution, or can be found
+   online at www.gnu.org/licenses.
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+  ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.rawmaterialsoftware.com/juce for more information.
+
+  ==============================================================================
+*/
+
+#ifndef __JUCE_ANIMATIONCLOCK_JUCEHEADER__
+#define __JUCE_ANIMATIONCLOCK_JUCEHEADER__
+
+
+//==============================================================================
+/**
+    A shared timer that drives animations in step with the screen being repainted.
+
+    Rather than each animation running its own Timer, which would tick out of phase with
+    the others and with the windows being repainted, a Listener can register with the
+    clock provided by Desktop::getAnimationClock(). On each frame the clock calls all the
+    listeners that are due, and if any of them are animating continuously, it then
+    immediately repaints any windows that they've invalidated, so that a frame's changes
+    all get drawn together.
+
+    Each listener says how long it'd like to wait before its next frame, so something
+    like a blinking caret won't make the clock run at full speed when nothing else is
+    moving, and its repaints are left to happen in the normal way.
+
+    @see Desktop::getAnimationClock, ComponentAnimator
+*/
+class JUCE_API  AnimationClock  : private Timer
+{
+public:
+    //==============================================================================
+    /** Creates a clock. You'll probably want to use the one in Desktop::getAnimationClock()
+        rather than creating your own.
+    */
+    AnimationClock();
+
+    /** Destructor. */
+    ~AnimationClock();
+
+    //==============================================================================
+    /**
+        Receives frame callbacks from an AnimationClock.
+
+        A listener is automatically removed from its clock when it's deleted.
+
+        @see AnimationClock::addListener
+    */
+    class JUCE_API  Listener
+    {
+    public:
+        Listener() noexcept;
+
+        /** Destructor. */
+        virtual ~Listener();
+
+        /** Called on the message thread for each frame in which this listener is due.
+
+            @param frameTime    the time of this frame, as returned by
+                                Time::getMillisecondCounterHiRes(). This is the same for all the
+                                listeners that get called during a frame, so use it rather than
+                                the current time when working out where your animation should be.
+            @returns            the number of milliseconds to wait before the next call. Returning
+                                0 means that you want to be called again on the next frame, and a
+                                value below zero will remove the listener from the clock. If this
+                                is less than one frame, the windows get repainted straight away.
+        */
+        virtual int animationFrame (double frameTime) = 0;
+
+    private:
+        friend class AnimationClock;
+        AnimationClock* clock;
+        double nextFrameTime;
+
+        JUCE_DECLARE_NON_COPYABLE (Listener);
+    };
+
+    /** Registers a listener with the clock.
+
+        If the listener is already registered, this just changes the time at which it'll
+        next be called.
+
+        @param listener                     the listener to add
+        @param millisecondsBeforeFirstFrame how long to wait before the listener's first callback,
+                                            or 0 for it to be called on the next frame
+    */
+    void addListener (Listener* listener, int millisecondsBeforeFirstFrame = 0);
+
+    /** Deregisters a listener. */
+    void removeListener (Listener* listener);
+
+    /** Returns true if the listener is currently registered with this clock. */
+    bool containsListener (Listener* listener) const noexcept;
+
+    //==============================================================================
+    /** Returns the time of the current (or most recent) frame.
+        This is in the same units as Time::getMillisecondCounterHiRes().
+    */
+    double getFrameTime() const noexcept                    { return frameTime; }
+
+    /** Returns the proportion of an animation that has elapsed by the current frame.
+
+        This is a quick way to make an animation time-based rather than frame-based: remember
+        the frame time when it starts, and each frame the value returned will go from 0 to 1
+        over the given duration, whatever the actual frame rate turned out to be.
+    */
+    double getProgress (double animationStartTime, double durationMilliseconds) const noexcept;
+
+    /** Changes the maximum number of frames per second. The default is 60. */
+    void setFrameRate (int framesPerSecond);
+
+    /** Returns the maximum number of frames per second. */
+    int getFrameRate() const noexcept                       { return framesPerSecond; }
+
+private:
+    //==============================================================================
+    Array <Listener*> listeners;
+    double frameTime, nextTimerCallbackTime;
+    int framesPerSecond;
+
+    void timerCallback();
+    void rescheduleTimer();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnimationClock);
+};
+
+
+#endif   // __JUCE_ANIMATIONCLOCK_JUCEHEADER__
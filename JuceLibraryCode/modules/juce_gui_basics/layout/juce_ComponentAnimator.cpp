@@ -237,10 +237,12 @@ void ComponentAnimator::animateComponent (Component* const component,
         at->reset (finalBounds, finalAlpha, millisecondsToSpendMoving,
                    useProxyComponent, startSpeed, endSpeed);
 
-        if (! isTimerRunning())
+        AnimationClock& clock = Desktop::getInstance().getAnimationClock();
+
+        if (! clock.containsListener (this))
         {
-            lastTime = Time::getMillisecondCounter();
-            startTimer (1000 / 50);
+            lastTime = Time::getMillisecondCounterHiRes();
+            clock.addListener (this);
         }
     }
 }
@@ -315,14 +317,11 @@ bool ComponentAnimator::isAnimating() const noexcept
     return tasks.size() != 0;
 }
 
-void ComponentAnimator::timerCallback()
+int ComponentAnimator::animationFrame (const double frameTime)
 {
-    const uint32 timeNow = Time::getMillisecondCounter();
-
-    if (lastTime == 0 || lastTime == timeNow)
-        lastTime = timeNow;
-
-    const int elapsed = (int) (timeNow - lastTime);
+    // (the elapsed time is rounded down, and any remainder carried over to the next frame)
+    const int elapsed = jmax (0, (int) (frameTime - lastTime));
+    lastTime += elapsed;
 
     for (int i = tasks.size(); --i >= 0;)
     {
@@ -333,8 +332,5 @@ void ComponentAnimator::timerCallback()
         }
     }
 
-    lastTime = timeNow;
-
-    if (tasks.size() == 0)
-        stopTimer();
+    return tasks.size() > 0 ? 0 : -1;
 }
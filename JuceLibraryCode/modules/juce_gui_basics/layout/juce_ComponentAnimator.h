@@ -27,6 +27,7 @@
 #define __JUCE_COMPONENTANIMATOR_JUCEHEADER__
 
 #include "../components/juce_Component.h"
+#include "juce_AnimationClock.h"
 
 
 //==============================================================================
@@ -48,10 +49,13 @@
     The class is a ChangeBroadcaster and sends a notification when any components
     start or finish being animated.
 
-    @see Desktop::getAnimator
+    The animations are driven by the shared clock from Desktop::getAnimationClock(), so
+    they move in step with each other and with the windows being repainted.
+
+    @see Desktop::getAnimator, AnimationClock
 */
 class JUCE_API  ComponentAnimator  : public ChangeBroadcaster,
-                                     private Timer
+                                     private AnimationClock::Listener
 {
 public:
     //==============================================================================
@@ -152,10 +156,10 @@ private:
     //==============================================================================
     class AnimationTask;
     OwnedArray <AnimationTask> tasks;
-    uint32 lastTime;
+    double lastTime;
 
     AnimationTask* findTaskFor (Component* component) const noexcept;
-    void timerCallback();
+    int animationFrame (double frameTime);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ComponentAnimator);
 };
@@ -30,21 +30,43 @@ namespace ComponentBuilderHelpers
         return state [ComponentBuilder::idProperty].toString();
     }
 
-    static Component* removeComponentWithID (OwnedArray<Component>& components, const String& compId)
+    // Takes the component with the given ID out of the array, leaving a null in its place. The
+    // search begins at startIndex, which is left pointing after the match, so that when the
+    // children are still in the same order as the last time, each one is found straight away.
+    static Component* removeComponentWithID (OwnedArray<Component>& components, const String& compId, int& startIndex)
     {
         jassert (compId.isNotEmpty());
 
-        for (int i = components.size(); --i >= 0;)
+        const int num = components.size();
+
+        for (int n = 0; n < num; ++n)
         {
+            const int i = (startIndex + n) % num;
             Component* const c = components.getUnchecked (i);
 
-            if (c->getComponentID() == compId)
-                return components.removeAndReturn (i);
+            if (c != nullptr && c->getComponentID() == compId)
+            {
+                components.set (i, nullptr, false);
+                startIndex = i + 1;
+                return c;
+            }
         }
 
         return nullptr;
     }
 
+    static bool childrenAreInOrder (Component& parent, const Array<Component*>& componentsInOrder)
+    {
+        if (parent.getNumChildComponents() != componentsInOrder.size())
+            return false;
+
+        for (int i = componentsInOrder.size(); --i >= 0;)
+            if (parent.getChildComponent (i) != componentsInOrder.getUnchecked (i))
+                return false;
+
+        return true;
+    }
+
     static Component* findComponentWithID (Component& c, const String& compId)
     {
         jassert (compId.isNotEmpty());
@@ -71,46 +93,34 @@ namespace ComponentBuilderHelpers
         return c;
     }
 
-    static void updateComponent (ComponentBuilder& builder, const ValueTree& state)
+    struct StateDepthComparator
     {
-        Component* topLevelComp = builder.getManagedComponent();
-
-        if (topLevelComp != nullptr)
+        static int getDepth (ValueTree v)
         {
-            ComponentBuilder::TypeHandler* const type = builder.getHandlerForState (state);
-            const String uid (getStateId (state));
+            int depth = 0;
 
-            if (type == nullptr || uid.isEmpty())
-            {
-                // ..handle the case where a child of the actual state node has changed.
-                if (state.getParent().isValid())
-                    updateComponent (builder, state.getParent());
-            }
-            else
-            {
-                Component* const changedComp = findComponentWithID (*topLevelComp, uid);
+            while ((v = v.getParent()).isValid())
+                ++depth;
 
-                if (changedComp != nullptr)
-                    type->updateComponentFromState (changedComp, state);
-            }
+            return depth;
         }
-    }
+
+        static int compareElements (const ValueTree& first, const ValueTree& second)
+        {
+            return getDepth (first) - getDepth (second);
+        }
+    };
 
     static void updateComponentColours (Component& component, const ValueTree& colourState)
     {
-        NamedValueSet& properties = component.getProperties();
+        const Array<int> existingColours (component.getExplicitColourIds());
 
-        for (int i = properties.size(); --i >= 0;)
+        for (int i = existingColours.size(); --i >= 0;)
         {
-            const Identifier name (properties.getName (i));
+            const int colourId = existingColours.getUnchecked (i);
 
-            if (name.toString().startsWith ("jcclr_"))
-            {
-                const String colourName (name.toString().substring (6));
-
-                if (colourState [colourName].isVoid())
-                    component.removeColour (colourName.getHexValue32());
-            }
+            if (colourState [String::toHexString (colourId)].isVoid())
+                component.removeColour (colourId);
         }
 
         for (int i = 0; i < colourState.getNumProperties(); ++i)
@@ -156,6 +166,13 @@ namespace ComponentBuilderHelpers
 const Identifier ComponentBuilder::idProperty ("id");
 const Identifier ComponentBuilder::positionID ("position");
 
+ComponentBuilder::UpdateStatistics::UpdateStatistics() noexcept
+    : numUpdates (0), numComponentsUpdated (0), numComponentsCreated (0), numComponentsDeleted (0),
+      lastUpdateTime (0), totalUpdateTime (0)
+{
+}
+
+//=============================================================================
 ComponentBuilder::ComponentBuilder()
     : imageProvider (nullptr)
 {
@@ -188,6 +205,10 @@ Component* ComponentBuilder::getManagedComponent()
         componentRef = component;
        #endif
     }
+    else
+    {
+        handleUpdateNowIfNeeded();
+    }
 
     return component;
 }
@@ -266,29 +287,138 @@ ComponentBuilder::ImageProvider* ComponentBuilder::getImageProvider() const noex
     return imageProvider;
 }
 
+const ComponentBuilder::UpdateStatistics& ComponentBuilder::getUpdateStatistics() const noexcept
+{
+    return statistics;
+}
+
+void ComponentBuilder::resetUpdateStatistics() noexcept
+{
+    statistics = UpdateStatistics();
+}
+
 void ComponentBuilder::valueTreePropertyChanged (ValueTree& tree, const Identifier&)
 {
-    ComponentBuilderHelpers::updateComponent (*this, tree);
+    stateChanged (tree);
 }
 
 void ComponentBuilder::valueTreeChildAdded (ValueTree& tree, ValueTree&)
 {
-    ComponentBuilderHelpers::updateComponent (*this, tree);
+    stateChanged (tree);
 }
 
 void ComponentBuilder::valueTreeChildRemoved (ValueTree& tree, ValueTree&)
 {
-    ComponentBuilderHelpers::updateComponent (*this, tree);
+    stateChanged (tree);
 }
 
 void ComponentBuilder::valueTreeChildOrderChanged (ValueTree& tree)
 {
-    ComponentBuilderHelpers::updateComponent (*this, tree);
+    stateChanged (tree);
 }
 
-void ComponentBuilder::valueTreeParentChanged (ValueTree& tree)
+void ComponentBuilder::valueTreeParentChanged (ValueTree&)
 {
-    ComponentBuilderHelpers::updateComponent (*this, tree);
+    // (this gets sent to every node in a subtree that's added or removed, but the
+    // valueTreeChildAdded/Removed callback for its new or old parent covers it)
+}
+
+void ComponentBuilder::stateChanged (const ValueTree& changedState)
+{
+    // If the component hasn't been created yet, it'll be built from the latest state anyway.
+    if (component != nullptr)
+    {
+        if (changedStates.size() == 0 || changedStates.getLast() != changedState)
+            changedStates.addIfNotAlreadyThere (changedState);
+
+        triggerAsyncUpdate();
+    }
+}
+
+ValueTree ComponentBuilder::findStateForComponent (ValueTree v) const
+{
+    // Finds the node that's represented by the component which needs updating when this
+    // node changes, or an invalid tree if the node isn't inside our state.
+    while (v.isValid() && v != state)
+    {
+        if (getHandlerForState (v) != nullptr && ComponentBuilderHelpers::getStateId (v).isNotEmpty())
+            break;
+
+        v = v.getParent();
+    }
+
+    return v;
+}
+
+Component* ComponentBuilder::findComponentForState (const ValueTree& s) const
+{
+    if (s == state)
+        return component;
+
+    // Rather than searching the whole hierarchy, find the parent's component and look at its children..
+    Component* const parent = findComponentForState (findStateForComponent (s.getParent()));
+
+    if (parent == nullptr)
+        return nullptr;
+
+    const String compId (ComponentBuilderHelpers::getStateId (s));
+
+    // (the components are normally in the same order as their states, so try that first)
+    {
+        Component* const c = parent->getChildComponent (s.getParent().indexOf (s));
+
+        if (c != nullptr && c->getComponentID() == compId)
+            return c;
+    }
+
+    for (int i = parent->getNumChildComponents(); --i >= 0;)
+    {
+        Component* const c = parent->getChildComponent (i);
+
+        if (c->getComponentID() == compId)
+            return c;
+    }
+
+    return ComponentBuilderHelpers::findComponentWithID (*parent, compId);
+}
+
+void ComponentBuilder::handleAsyncUpdate()
+{
+    const double startTime = Time::getMillisecondCounterHiRes();
+
+    Array<ValueTree> statesToUpdate;
+
+    for (int i = 0; i < changedStates.size(); ++i)
+    {
+        const ValueTree s (findStateForComponent (changedStates.getReference (i)));
+
+        if (s.isValid())
+            statesToUpdate.addIfNotAlreadyThere (s);
+    }
+
+    changedStates.clear();
+
+    // Update parents before their children, so that children which get deleted by
+    // their parent's update aren't updated needlessly beforehand.
+    ComponentBuilderHelpers::StateDepthComparator comparator;
+    statesToUpdate.sort (comparator, true);
+
+    for (int i = 0; i < statesToUpdate.size(); ++i)
+    {
+        const ValueTree& s = statesToUpdate.getReference (i);
+        TypeHandler* const type = getHandlerForState (s);
+        Component* const c = findComponentForState (s);
+
+        if (type != nullptr && c != nullptr)
+        {
+            type->updateComponentFromState (c, s);
+            ++statistics.numComponentsUpdated;
+        }
+    }
+
+    statistics.lastUpdateTime = Time::getMillisecondCounterHiRes() - startTime;
+    statistics.totalUpdateTime += statistics.lastUpdateTime;
+    ++statistics.numUpdates;
 }
 
 //==============================================================================
@@ -325,11 +455,12 @@ void ComponentBuilder::updateChildComponents (Component& parent, const ValueTree
         for (i = 0; i < numExistingChildComps; ++i)
             existingComponents.add (parent.getChildComponent (i));
 
+        int searchStartIndex = 0;
         const int newNumChildren = children.getNumChildren();
         for (i = 0; i < newNumChildren; ++i)
         {
             const ValueTree childState (children.getChild (i));
-            Component* c = removeComponentWithID (existingComponents, getStateId (childState));
+            Component* c = removeComponentWithID (existingComponents, getStateId (childState), searchStartIndex);
 
             if (c == nullptr)
             {
@@ -337,7 +468,10 @@ void ComponentBuilder::updateChildComponents (Component& parent, const ValueTree
                 jassert (type != nullptr);
 
                 if (type != nullptr)
+                {
                     c = ComponentBuilderHelpers::createNewComponent (*type, childState, &parent);
+                    ++statistics.numComponentsCreated;
+                }
             }
 
             if (c != nullptr)
@@ -345,10 +479,13 @@ void ComponentBuilder::updateChildComponents (Component& parent, const ValueTree
         }
 
         // (remaining unused items in existingComponents get deleted here as it goes out of scope)
+        for (i = existingComponents.size(); --i >= 0;)
+            if (existingComponents.getUnchecked (i) != nullptr)
+                ++statistics.numComponentsDeleted;
     }
 
     // Make sure the z-order is correct..
-    if (componentsInOrder.size() > 0)
+    if (componentsInOrder.size() > 0 && ! childrenAreInOrder (parent, componentsInOrder))
     {
         componentsInOrder.getLast()->toFront (false);
 
@@ -439,3 +576,70 @@ void ComponentBuilder::refreshBasicComponentProperties (Component& comp, const V
 
     ComponentBuilderHelpers::updateComponentColours (comp, state.getChildWithName ("COLOURS"));
 }
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ComponentBuilderTests  : public UnitTest
+{
+public:
+    ComponentBuilderTests() : UnitTest ("ComponentBuilder") {}
+
+    static ValueTree createRectangleState (const String& compId, const float x)
+    {
+        DrawableRectangle r;
+        r.setComponentID (compId);
+        r.setRectangle (RelativeParallelogram (Rectangle<float> (x, 0.0f, 10.0f, 10.0f)));
+        return r.createValueTree (nullptr);
+    }
+
+    void runTest()
+    {
+        beginTest ("Incremental updates");
+
+        const int numChildren = 1000;
+
+        DrawableComposite composite;
+        composite.setComponentID ("top");
+        ValueTree state (composite.createValueTree (nullptr));
+        ValueTree childList (DrawableComposite::ValueTreeWrapper (state).getChildListCreating (nullptr));
+
+        for (int i = 0; i < numChildren; ++i)
+            childList.addChild (createRectangleState ("r" + String (i), (float) i), -1, nullptr);
+
+        ComponentBuilder builder (state);
+        Drawable::registerDrawableTypeHandlers (builder);
+
+        Drawable* const d = dynamic_cast <Drawable*> (builder.getManagedComponent());
+        expect (d != nullptr && d->getNumChildComponents() == numChildren);
+
+        // A property change should only update the component that it belongs to..
+        for (int i = 0; i < 10; ++i)
+            DrawableRectangle::ValueTreeWrapper (childList.getChild (i * 50))
+                .setRectangle (RelativeParallelogram (Rectangle<float> (5.0f, 5.0f, 20.0f, 20.0f)), nullptr);
+
+        builder.resetUpdateStatistics();
+        builder.getManagedComponent();
+        expectEquals (builder.getUpdateStatistics().numUpdates, 1);
+        expectEquals (builder.getUpdateStatistics().numComponentsUpdated, 10);
+        expect (d->createValueTree (nullptr).isEquivalentTo (state));
+
+        // ..and adding or removing children should only create or delete those ones.
+        childList.addChild (createRectangleState ("new1", 1.0f), 10, nullptr);
+        childList.addChild (createRectangleState ("new2", 2.0f), -1, nullptr);
+        childList.removeChild (500, nullptr);
+        childList.moveChild (20, 3, nullptr);
+
+        builder.resetUpdateStatistics();
+        builder.getManagedComponent();
+        expectEquals (builder.getUpdateStatistics().numComponentsUpdated, 1);
+        expectEquals (builder.getUpdateStatistics().numComponentsCreated, 2);
+        expectEquals (builder.getUpdateStatistics().numComponentsDeleted, 1);
+        expectEquals (d->getNumChildComponents(), numChildren + 1);
+        expect (d->createValueTree (nullptr).isEquivalentTo (state));
+    }
+};
+
+static ComponentBuilderTests componentBuilderTests;
+
+#endif
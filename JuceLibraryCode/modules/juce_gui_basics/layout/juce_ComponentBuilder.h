@@ -44,8 +44,14 @@
     Once you've got the component you can either take it and delete the ComponentBuilder
     object, or if you keep the ComponentBuilder around, it'll monitor any changes in the
     ValueTree and automatically update the component to reflect these changes.
+
+    The changes are applied asynchronously, so that a burst of changes to the tree only
+    updates each affected component once, on the next message-loop callback. Only the
+    components whose states have changed are updated, and when children are added or
+    removed, only those children are created or deleted.
 */
-class JUCE_API  ComponentBuilder  : public ValueTree::Listener
+class JUCE_API  ComponentBuilder  : public ValueTree::Listener,
+                                    private AsyncUpdater
 {
 public:
     /** Creates a ComponentBuilder that will use the given state.
@@ -78,7 +84,8 @@ public:
 
         The ComponentBuilder will update this component if any changes are made to the ValueTree, so if
         there's a chance that the tree might change, be careful not to keep any pointers to sub-components,
-        as they may be changed or removed.
+        as they may be changed or removed. Any changes to the tree that are still waiting to be applied
+        will be applied before this method returns.
     */
     Component* getManagedComponent();
 
@@ -233,6 +240,31 @@ public:
                                          const ValueTree& state,
                                          ImageProvider* imageProvider);
 
+    //=============================================================================
+    /** Holds some statistics about the work that the builder has done to keep its
+        managed component up to date with changes to the ValueTree.
+        @see getUpdateStatistics
+    */
+    struct UpdateStatistics
+    {
+        UpdateStatistics() noexcept;
+
+        int numUpdates;             /**< The number of batches of changes that have been applied. */
+        int numComponentsUpdated;   /**< The number of times a TypeHandler has been asked to update a component. */
+        int numComponentsCreated;   /**< The number of child components that have been created by updateChildComponents(). */
+        int numComponentsDeleted;   /**< The number of child components that have been deleted by updateChildComponents(). */
+        double lastUpdateTime;      /**< The number of milliseconds that the most recent batch took. */
+        double totalUpdateTime;     /**< The total number of milliseconds spent applying changes. */
+    };
+
+    /** Returns the statistics for the updates that have been made since the builder was
+        created, or since resetUpdateStatistics() was called.
+    */
+    const UpdateStatistics& getUpdateStatistics() const noexcept;
+
+    /** Clears the statistics that getUpdateStatistics() returns. */
+    void resetUpdateStatistics() noexcept;
+
     //=============================================================================
     /** @internal */
     void valueTreePropertyChanged (ValueTree& treeWhosePropertyHasChanged, const Identifier& property);
@@ -257,9 +289,15 @@ private:
    #if JUCE_DEBUG
     WeakReference<Component> componentRef;
    #endif
+    Array<ValueTree> changedStates;
+    UpdateStatistics statistics;
 
     static const Identifier positionID;
     void initialiseRecursively (Component&, const ValueTree&);
+    void stateChanged (const ValueTree&);
+    ValueTree findStateForComponent (ValueTree) const;
+    Component* findComponentForState (const ValueTree&) const;
+    void handleAsyncUpdate();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ComponentBuilder);
 };
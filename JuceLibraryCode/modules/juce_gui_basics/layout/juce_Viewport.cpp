@@ -31,6 +31,7 @@ Viewport::Viewport (const String& name)
     showHScrollbar (true),
     showVScrollbar (true),
     deleteContent (true),
+    blitScrolling (false),
     verticalScrollBar (true),
     horizontalScrollBar (false)
 {
@@ -113,7 +114,57 @@ void Viewport::setViewPosition (const int xPixelsOffset, const int yPixelsOffset
 void Viewport::setViewPosition (const Point<int>& newPosition)
 {
     if (contentComp != nullptr)
-        contentComp->setTopLeftPosition (viewportPosToCompPos (newPosition));
+        setContentCompPos (viewportPosToCompPos (newPosition));
+}
+
+void Viewport::setContentCompPos (const Point<int>& newPos)
+{
+    if (! (blitScrolling && scrollContentByCopying (newPos)))
+        contentComp->setTopLeftPosition (newPos.getX(), newPos.getY());
+}
+
+bool Viewport::scrollContentByCopying (const Point<int>& newPos)
+{
+    const Point<int> delta (newPos - contentComp->getPosition());
+    const Rectangle<int> visibleArea (contentHolder.getLocalBounds());
+
+    if (delta.isOrigin()
+         || ! isShowing()
+         || ! contentComp->isOpaque()
+         || contentComp->isTransformed()
+         || ! contentComp->getBounds().contains (visibleArea)
+         || ! (contentComp->getBounds() + delta).contains (visibleArea))
+        return false;
+
+    ComponentPeer* const peer = getPeer();
+
+    if (peer == nullptr)
+        return false;
+
+    // Find the area that the content holder occupies in the peer, making sure that nothing
+    // could be drawn on top of it or blended into it..
+    Rectangle<int> area (visibleArea);
+
+    for (Component* c = &contentHolder; ! c->isOnDesktop(); c = c->getParentComponent())
+    {
+        Component* const parent = c->getParentComponent();
+
+        if (parent == nullptr || c->isTransformed() || c->getAlpha() < 1.0f)
+            return false;
+
+        area = (area + c->getPosition()).getIntersection (parent->getLocalBounds());
+
+        for (int i = parent->getIndexOfChildComponent (c) + 1; i < parent->getNumChildComponents(); ++i)
+        {
+            const Component* const sibling = parent->getChildComponent (i);
+
+            if (sibling->isVisible() && sibling->getBoundsInParent().intersects (area))
+                return false;
+        }
+    }
+
+    return ! area.isEmpty()
+            && peer->scrollArea (area, delta, *contentComp, newPos);
 }
 
 void Viewport::setViewPositionProportionately (const double x, const double y)
@@ -157,8 +208,7 @@ bool Viewport::autoScroll (const int mouseX, const int mouseY, const int activeB
 
         if (dx != 0 || dy != 0)
         {
-            contentComp->setTopLeftPosition (contentComp->getX() + dx,
-                                             contentComp->getY() + dy);
+            setContentCompPos (contentComp->getPosition() + Point<int> (dx, dy));
 
             return true;
         }
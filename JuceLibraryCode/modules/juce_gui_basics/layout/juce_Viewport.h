@@ -241,6 +241,28 @@ public:
     */
     ScrollBar* getHorizontalScrollBar() noexcept                { return &horizontalScrollBar; }
 
+    /** Enables scrolling by shifting the pixels that are already on-screen.
+
+        When this is turned on and the view position changes, the window's existing image
+        of the content is moved, and only the strip that gets uncovered is repainted. This
+        is only done when it's safe: the content component must be opaque and fill the
+        viewport, no other components may overlap it, and none of its parents can be
+        transformed or semi-transparent. Otherwise, or if the platform doesn't support it,
+        the whole visible area gets repainted as normal.
+
+        Only use this if the content's appearance doesn't depend on its scroll position,
+        because repaints that the content triggers inside the copied area while it's being
+        moved will be skipped.
+
+        By default this is disabled.
+    */
+    void setBlitScrollingEnabled (bool shouldScrollByCopying) noexcept  { blitScrolling = shouldScrollByCopying; }
+
+    /** Returns true if scrolling by copying has been enabled.
+        @see setBlitScrollingEnabled
+    */
+    bool isBlitScrollingEnabled() const noexcept                { return blitScrolling; }
+
 
     //==============================================================================
     struct Ids
@@ -270,12 +292,15 @@ private:
     Rectangle<int> lastVisibleArea;
     int scrollBarThickness;
     int singleStepX, singleStepY;
-    bool showHScrollbar, showVScrollbar, deleteContent;
+    bool showHScrollbar, showVScrollbar, deleteContent, blitScrolling;
     Component contentHolder;
     ScrollBar verticalScrollBar;
     ScrollBar horizontalScrollBar;
     Point<int> viewportPosToCompPos (const Point<int>&) const;
 
+    void setContentCompPos (const Point<int>&);
+    bool scrollContentByCopying (const Point<int>&);
+
     void updateVisibleArea();
     void deleteContentComp();
 
@@ -267,10 +267,8 @@ LookAndFeel::~LookAndFeel()
 //==============================================================================
 Colour LookAndFeel::findColour (const int colourId) const noexcept
 {
-    const int index = colourIds.indexOf (colourId);
-
-    if (index >= 0)
-        return colours [index];
+    if (colours.contains (colourId))
+        return colours [colourId];
 
     jassertfalse;
     return Colours::black;
@@ -278,22 +276,12 @@ Colour LookAndFeel::findColour (const int colourId) const noexcept
 
 void LookAndFeel::setColour (const int colourId, const Colour& colour) noexcept
 {
-    const int index = colourIds.indexOf (colourId);
-
-    if (index >= 0)
-    {
-        colours.set (index, colour);
-    }
-    else
-    {
-        colourIds.add (colourId);
-        colours.add (colour);
-    }
+    colours.set (colourId, colour);
 }
 
 bool LookAndFeel::isColourSpecified (const int colourId) const noexcept
 {
-    return colourIds.contains (colourId);
+    return colours.contains (colourId);
 }
 
 //==============================================================================
@@ -1341,14 +1329,7 @@ void LookAndFeel::drawLabel (Graphics& g, Label& label)
 
         g.setColour (label.findColour (Label::textColourId).withMultipliedAlpha (alpha));
         g.setFont (label.getFont());
-        g.drawFittedText (label.getText(),
-                          label.getHorizontalBorderSize(),
-                          label.getVerticalBorderSize(),
-                          label.getWidth() - 2 * label.getHorizontalBorderSize(),
-                          label.getHeight() - 2 * label.getVerticalBorderSize(),
-                          label.getJustificationType(),
-                          jmax (1, (int) (label.getHeight() / label.getFont().getHeight())),
-                          label.getMinimumHorizontalScale());
+        label.getFittedText().draw (g);
 
         g.setColour (label.findColour (Label::outlineColourId).withMultipliedAlpha (alpha));
         g.drawRect (0, 0, label.getWidth(), label.getHeight());
@@ -654,8 +654,7 @@ private:
     friend class WeakReference<LookAndFeel>;
     WeakReference<LookAndFeel>::Master masterReference;
 
-    Array <int> colourIds;
-    Array <Colour> colours;
+    HashMap <int, Colour> colours;
 
     // default typeface names
     String defaultSans, defaultSerif, defaultFixed;
@@ -23,14 +23,26 @@
   ==============================================================================
 */
 
+/*  Draws either one edge of the shadow, or all four of them.
+
+    Normally a single window covers the owner's area as well as the shadow around it,
+    leaving the middle transparent, as the owner always hides it. That means moving the
+    owner only needs one window to be re-positioned, and as only the edges ever get
+    repainted, the middle costs nothing to keep up-to-date.
+
+    On Windows, a layered window has to re-upload its whole area whenever any part of it
+    is repainted, so desktop windows get one window per edge instead.
+*/
 class ShadowWindow  : public Component
 {
 public:
-    ShadowWindow (Component& owner, const int type_, const Image shadowImageSections [12])
-        : topLeft (shadowImageSections [type_ * 3]),
-          bottomRight (shadowImageSections [type_ * 3 + 1]),
-          filler (shadowImageSections [type_ * 3 + 2]),
-          type (type_)
+    enum { allEdges = 4 };
+
+    ShadowWindow (Component& owner, const int shadowEdge_, const Image shadowImageSections_ [12],
+                  const int edgeType_)
+        : shadowImageSections (shadowImageSections_),
+          shadowEdge (shadowEdge_),
+          edgeType (edgeType_)
     {
         setInterceptsMouseClicks (false, false);
 
@@ -51,51 +63,110 @@ public:
     {
         g.setOpacity (1.0f);
 
+        for (int i = 0; i < 4; ++i)
+        {
+            if (edgeType != allEdges && edgeType != i)
+                continue;
+
+            const Rectangle<int> area (getEdgeArea (i));
+
+            if (g.clipRegionIntersects (area))
+            {
+                Graphics::ScopedSaveState ss (g);
+                g.reduceClipRegion (area);
+                g.setOrigin (area.getX(), area.getY());
+                paintEdge (g, i, area.getWidth(), area.getHeight());
+            }
+        }
+    }
+
+    void resized()
+    {
+        if (edgeType != allEdges)
+        {
+            repaint();  // (needed for correct repainting)
+        }
+        else
+        {
+            // (needed for correct repainting, but the middle never shows, so leave that alone)
+            for (int i = 0; i < 4; ++i)
+                repaint (getEdgeArea (i));
+        }
+    }
+
+private:
+    const Image* const shadowImageSections;
+    const int shadowEdge;
+    const int edgeType;
+
+    // 0 = left, 1 = right, 2 = top, 3 = bottom. left + right are full-height
+    Rectangle<int> getEdgeArea (const int type) const noexcept
+    {
+        if (edgeType != allEdges)
+            return getLocalBounds();
+
+        const int w = getWidth(), h = getHeight();
+
+        switch (type)
+        {
+            case 0:  return Rectangle<int> (0, 0, shadowEdge, h);
+            case 1:  return Rectangle<int> (w - shadowEdge, 0, shadowEdge, h);
+            case 2:  return Rectangle<int> (shadowEdge, 0, w - shadowEdge * 2, shadowEdge);
+            default: return Rectangle<int> (shadowEdge, h - shadowEdge, w - shadowEdge * 2, shadowEdge);
+        }
+    }
+
+    void paintEdge (Graphics& g, const int type, const int width, const int height) const
+    {
+        const Image& topLeft     = shadowImageSections [type * 3];
+        const Image& bottomRight = shadowImageSections [type * 3 + 1];
+        const Image& filler      = shadowImageSections [type * 3 + 2];
+
         if (type < 2)
         {
-            int imH = jmin (topLeft.getHeight(), getHeight() / 2);
+            int imH = jmin (topLeft.getHeight(), height / 2);
             g.drawImage (topLeft,
                          0, 0, topLeft.getWidth(), imH,
                          0, 0, topLeft.getWidth(), imH);
 
-            imH = jmin (bottomRight.getHeight(), getHeight() - getHeight() / 2);
+            imH = jmin (bottomRight.getHeight(), height - height / 2);
             g.drawImage (bottomRight,
-                         0, getHeight() - imH, bottomRight.getWidth(), imH,
+                         0, height - imH, bottomRight.getWidth(), imH,
                          0, bottomRight.getHeight() - imH, bottomRight.getWidth(), imH);
 
             g.setTiledImageFill (filler, 0, 0, 1.0f);
-            g.fillRect (0, topLeft.getHeight(), getWidth(), getHeight() - (topLeft.getHeight() + bottomRight.getHeight()));
+            g.fillRect (0, topLeft.getHeight(), width, height - (topLeft.getHeight() + bottomRight.getHeight()));
         }
         else
         {
-            int imW = jmin (topLeft.getWidth(), getWidth() / 2);
+            int imW = jmin (topLeft.getWidth(), width / 2);
             g.drawImage (topLeft,
                          0, 0, imW, topLeft.getHeight(),
                          0, 0, imW, topLeft.getHeight());
 
-            imW = jmin (bottomRight.getWidth(), getWidth() - getWidth() / 2);
+            imW = jmin (bottomRight.getWidth(), width - width / 2);
             g.drawImage (bottomRight,
-                         getWidth() - imW, 0, imW, bottomRight.getHeight(),
+                         width - imW, 0, imW, bottomRight.getHeight(),
                          bottomRight.getWidth() - imW, 0, imW, bottomRight.getHeight());
 
             g.setTiledImageFill (filler, 0, 0, 1.0f);
-            g.fillRect (topLeft.getWidth(), 0, getWidth() - (topLeft.getWidth() + bottomRight.getWidth()), getHeight());
+            g.fillRect (topLeft.getWidth(), 0, width - (topLeft.getWidth() + bottomRight.getWidth()), height);
         }
     }
 
-    void resized()
-    {
-        repaint();  // (needed for correct repainting)
-    }
-
-private:
-    const Image topLeft, bottomRight, filler;
-    const int type;   // 0 = left, 1 = right, 2 = top, 3 = bottom. left + right are full-height
-
     JUCE_DECLARE_NON_COPYABLE (ShadowWindow);
 };
 
 
+static bool canUseSingleShadowWindowOnDesktop() noexcept
+{
+   #if JUCE_WINDOWS
+    return false;
+   #else
+    return true;
+   #endif
+}
+
 //==============================================================================
 DropShadower::DropShadower (const float alpha_,
                             const int xOffset_,
@@ -169,12 +240,12 @@ void DropShadower::updateShadows()
     ComponentPeer* const peer = owner->getPeer();
     const bool isOwnerVisible = owner->isVisible() && (peer == nullptr || ! peer->isMinimised());
 
-    const bool createShadowWindows  = shadowWindows.size() == 0
-                                         && owner->getWidth() > 0
-                                         && owner->getHeight() > 0
-                                         && isOwnerVisible
-                                         && (Desktop::canUseSemiTransparentWindows()
-                                              || owner->getParentComponent() != nullptr);
+    const bool createShadowWindows = shadowWindows.size() == 0
+                                       && owner->getWidth() > 0
+                                       && owner->getHeight() > 0
+                                       && isOwnerVisible
+                                       && (owner->getParentComponent() != nullptr
+                                            || Desktop::canUseSemiTransparentWindows());
 
     {
         const ScopedValueSetter<bool> setter (reentrant, true, false);
@@ -229,30 +300,42 @@ void DropShadower::updateShadows()
             setShadowImage (bigIm, 10, shadowEdge, shadowEdge, iw - shadowEdge2, ih - shadowEdge);
             setShadowImage (bigIm, 11, shadowEdge, shadowEdge, shadowEdge2, ih - shadowEdge);
 
-            for (int i = 0; i < 4; ++i)
-                shadowWindows.add (new ShadowWindow (*owner, i, shadowImageSections));
+            if (owner->isOnDesktop() && ! canUseSingleShadowWindowOnDesktop())
+            {
+                for (int i = 0; i < 4; ++i)
+                    shadowWindows.add (new ShadowWindow (*owner, shadowEdge, shadowImageSections, i));
+            }
+            else
+            {
+                shadowWindows.add (new ShadowWindow (*owner, shadowEdge, shadowImageSections,
+                                                     ShadowWindow::allEdges));
+            }
         }
 
-        if (shadowWindows.size() >= 4)
-        {
-            const int x = owner->getX();
-            const int y = owner->getY() - shadowEdge;
-            const int w = owner->getWidth();
-            const int h = owner->getHeight() + shadowEdge + shadowEdge;
+        const int x = owner->getX();
+        const int y = owner->getY() - shadowEdge;
+        const int w = owner->getWidth();
+        const int h = owner->getHeight() + shadowEdge + shadowEdge;
 
-            for (int i = shadowWindows.size(); --i >= 0;)
-            {
-                // there seem to be rare situations where the dropshadower may be deleted by
-                // callbacks during this loop, so use a weak ref to watch out for this..
-                WeakReference<Component> sw (shadowWindows[i]);
+        for (int i = shadowWindows.size(); --i >= 0;)
+        {
+            // there seem to be rare situations where the dropshadower may be deleted by
+            // callbacks during this loop, so use a weak ref to watch out for this..
+            WeakReference<Component> sw (shadowWindows[i]);
 
-                if (sw != nullptr)
-                    sw->setAlwaysOnTop (owner->isAlwaysOnTop());
+            if (sw != nullptr)
+                sw->setAlwaysOnTop (owner->isAlwaysOnTop());
 
-                if (sw != nullptr)
-                    sw->setVisible (isOwnerVisible);
+            if (sw != nullptr)
+                sw->setVisible (isOwnerVisible);
 
-                if (sw != nullptr)
+            if (sw != nullptr)
+            {
+                if (shadowWindows.size() == 1)
+                {
+                    sw->setBounds (owner->getBounds().expanded (shadowEdge, shadowEdge));
+                }
+                else
                 {
                     switch (i)
                     {
@@ -263,10 +346,10 @@ void DropShadower::updateShadows()
                         default: break;
                     }
                 }
-
-                if (sw == nullptr)
-                    return;
             }
+
+            if (sw == nullptr)
+                return;
         }
     }
 
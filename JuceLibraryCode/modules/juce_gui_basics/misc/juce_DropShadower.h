@@ -33,10 +33,10 @@
 /**
     Adds a drop-shadow to a component.
 
-    This object creates and manages a set of components which sit around a
-    component, creating a gaussian shadow around it. The components will track
-    the position of the component and if it's brought to the front they'll also
-    follow this.
+    This object creates and manages a component which sits behind the one you want
+    to shadow, drawing a gaussian shadow around its edges. (On Windows, desktop
+    windows get a separate one for each edge instead). It will track the position
+    of the component, and if that's brought to the front, it'll follow it.
 
     For desktop windows you don't need to use this class directly - just
     set the Component::windowHasDropShadow flag when calling
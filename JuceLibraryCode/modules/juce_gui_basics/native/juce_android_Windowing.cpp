@@ -439,6 +439,7 @@ public:
 
     void performAnyPendingRepaintsNow()
     {
+        Component::dispatchPendingRepaints();
         // TODO
     }
 
@@ -961,6 +961,7 @@ void UIViewComponentPeer::repaint (const Rectangle<int>& area)
 
 void UIViewComponentPeer::performAnyPendingRepaintsNow()
 {
+    Component::dispatchPendingRepaints();
 }
 
 ComponentPeer* Component::createNewPeer (int styleFlags, void* windowToAttachTo)
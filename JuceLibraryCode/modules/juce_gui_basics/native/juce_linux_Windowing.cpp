@@ -146,6 +146,50 @@ bool KeyPress::isKeyCurrentlyDown (const int keyCode)
     return (Keys::keyStates [keybyte] & keybit) != 0;
 }
 
+//==============================================================================
+/*  In debug builds, this keeps count of the Xlib calls which have to wait for a reply
+    from the server, so that it's easy to see how many round trips the message thread is
+    making. Each call site that blocks on a reply calls add().
+*/
+namespace RoundTripCounter
+{
+   #if JUCE_DEBUG
+    static uint32 currentSecond = 0;
+    static int numThisSecond = 0, numLastSecond = 0, totalNum = 0;
+
+    static void updateSecond() noexcept
+    {
+        const uint32 now = Time::getApproximateMillisecondCounter() / 1000;
+
+        if (now != currentSecond)
+        {
+            numLastSecond = (now == currentSecond + 1) ? numThisSecond : 0;
+            numThisSecond = 0;
+            currentSecond = now;
+        }
+    }
+
+    static void add() noexcept
+    {
+        updateSecond();
+        ++numThisSecond;
+        ++totalNum;
+    }
+
+    /** Returns the number of round trips made during the last complete second. */
+    static int getNumInLastSecond() noexcept
+    {
+        updateSecond();
+        return numLastSecond;
+    }
+
+    /** Returns the number of round trips made since the app started. */
+    static int getTotal() noexcept      { return totalNum; }
+   #else
+    static inline void add() noexcept   {}
+   #endif
+}
+
 //==============================================================================
 #if JUCE_USE_XSHM
 namespace XSHMHelpers
@@ -744,7 +788,7 @@ public:
     LinuxComponentPeer (Component* const component, const int windowStyleFlags, Window parentToAddTo)
         : ComponentPeer (component, windowStyleFlags),
           windowH (0), parentWindow (0),
-          fullScreen (false), mapped (false),
+          fullScreen (false), mapped (false), focusPendingUntilMapped (false),
           visual (0), depth (0)
     {
         // it's dangerous to create a window on a thread other than the message thread..
@@ -766,6 +810,9 @@ public:
 
         destroyWindow();
 
+        if (windowContainingPointer == windowH)
+            windowContainingPointer = 0;
+
         windowH = 0;
     }
 
@@ -791,9 +838,14 @@ public:
     {
         ScopedXLock xlock;
         if (shouldBeVisible)
+        {
             XMapWindow (display, windowH);
+        }
         else
+        {
+            focusPendingUntilMapped = false;
             XUnmapWindow (display, windowH);
+        }
     }
 
     void setTitle (const String& title)
@@ -999,6 +1051,7 @@ public:
 
         ScopedXLock xlock;
         Window parent, root = RootWindow (display, DefaultScreen (display));
+        RoundTripCounter::add();
 
         if (XQueryTree (display, root, &root, &parent, &windowList, &windowListSize) != 0)
         {
@@ -1039,14 +1092,13 @@ public:
         if (trueIfInAChildWindow)
             return true;
 
-        ::Window root, child;
+        ::Window child;
         int wx, wy;
-        unsigned int ww, wh, bw, depth;
 
         ScopedXLock xlock;
+        RoundTripCounter::add();
 
-        return XGetGeometry (display, (::Drawable) windowH, &root, &wx, &wy, &ww, &wh, &bw, &depth)
-                && XTranslateCoordinates (display, windowH, windowH, position.getX(), position.getY(), &wx, &wy, &child)
+        return XTranslateCoordinates (display, windowH, windowH, position.getX(), position.getY(), &wx, &wy, &child)
                 && child == None;
     }
 
@@ -1086,13 +1138,10 @@ public:
             XSendEvent (display, RootWindow (display, DefaultScreen (display)),
                         False, SubstructureRedirectMask | SubstructureNotifyMask, &ev);
 
-            XWindowAttributes attr;
-            XGetWindowAttributes (display, windowH, &attr);
-
             if (component->isAlwaysOnTop())
                 XRaiseWindow (display, windowH);
 
-            XSync (display, False);
+            XFlush (display);
         }
 
         handleBroughtToFront();
@@ -1119,6 +1168,7 @@ public:
         int revert = 0;
         Window focusedWindow = 0;
         ScopedXLock xlock;
+        RoundTripCounter::add();
         XGetInputFocus (display, &focusedWindow, &revert);
 
         return focusedWindow == windowH;
@@ -1126,13 +1176,17 @@ public:
 
     void grabFocus()
     {
-        XWindowAttributes atts;
         ScopedXLock xlock;
 
-        if (windowH != 0
-            && XGetWindowAttributes (display, windowH, &atts)
-            && atts.map_state == IsViewable
-            && ! isFocused())
+        // (the mapped flag follows the MapNotify/UnmapNotify events, so there's no need to ask the
+        // server. If the window has been shown but the MapNotify hasn't arrived yet, the focus is
+        // taken when it does, because XSetInputFocus fails on an unmapped window)
+        if (windowH != 0 && ! mapped)
+        {
+            focusPendingUntilMapped = true;
+        }
+        else if (windowH != 0
+                  && ! isFocused())
         {
             XSetInputFocus (display, windowH, RevertToParent, CurrentTime);
             isActiveApplication = true;
@@ -1153,6 +1207,28 @@ public:
         repainter->performAnyPendingRepaintsNow();
     }
 
+    bool scrollArea (const Rectangle<int>& areaToScroll, const Point<int>& delta,
+                     Component& componentToMove, const Point<int>& newComponentPosition)
+    {
+        const Rectangle<int> area (areaToScroll.getIntersection (getComponent()->getLocalBounds()));
+
+        if ((! mapped) || (! maskedRegion.isEmpty())
+             || std::abs (delta.getX()) >= area.getWidth()
+             || std::abs (delta.getY()) >= area.getHeight())
+            return false;
+
+        // Lightweight repaints are held back until they're dispatched, so flush any that are
+        // already waiting (they need to be moved along with the pixels), and then flush the
+        // ones caused by moving the component while the repainter still knows which area
+        // has been copied, so that it can ignore them.
+        Component::dispatchPendingRepaints();
+        repainter->scrollArea (area, delta);
+        componentToMove.setTopLeftPosition (newComponentPosition.getX(), newComponentPosition.getY());
+        Component::dispatchPendingRepaints();
+        repainter->scrollFinished();
+        return true;
+    }
+
     void setIcon (const Image& newIcon)
     {
         const int dataSize = newIcon.getWidth() * newIcon.getHeight() + 2;
@@ -1225,6 +1301,7 @@ public:
             case FocusIn:               handleFocusInEvent(); break;
             case FocusOut:              handleFocusOutEvent(); break;
             case Expose:                handleExposeEvent ((XExposeEvent*) &event->xexpose); break;
+            case GraphicsExpose:        handleGraphicsExposeEvent ((const XGraphicsExposeEvent*) &event->xgraphicsexpose); break;
             case MappingNotify:         handleMappingNotify ((XMappingEvent*) &event->xmapping); break;
             case ClientMessage:         handleClientMessageEvent ((XClientMessageEvent*) &event->xclient, event); break;
             case SelectionNotify:       handleDragAndDropSelection (event); break;
@@ -1241,14 +1318,26 @@ public:
             case MapNotify:
                 mapped = true;
                 handleBroughtToFront();
+
+                if (focusPendingUntilMapped)
+                {
+                    focusPendingUntilMapped = false;
+                    grabFocus();
+                }
+
                 break;
 
             case UnmapNotify:
                 mapped = false;
+
+                if (windowContainingPointer == windowH)
+                    windowContainingPointer = 0;
+
                 break;
 
             case SelectionClear:
             case SelectionRequest:
+            case NoExpose:
                 break;
 
             default:
@@ -1418,6 +1507,7 @@ public:
     void handleButtonPressEvent (const XButtonPressedEvent* const buttonPressEvent)
     {
         updateKeyModifiers (buttonPressEvent->state);
+        pointerPosition = Point<int> (buttonPressEvent->x_root, buttonPressEvent->y_root);
 
         switch (pointerMap [buttonPressEvent->button - Button1])
         {
@@ -1435,6 +1525,7 @@ public:
     void handleButtonReleaseEvent (const XButtonReleasedEvent* const buttonRelEvent)
     {
         updateKeyModifiers (buttonRelEvent->state);
+        pointerPosition = Point<int> (buttonRelEvent->x_root, buttonRelEvent->y_root);
 
         switch (pointerMap [buttonRelEvent->button - Button1])
         {
@@ -1450,46 +1541,71 @@ public:
         clearLastMousePos();
     }
 
-    void handleMotionNotifyEvent (const XPointerMovedEvent* const movedEvent)
+    void handleMotionNotifyEvent (const XPointerMovedEvent* const firstEvent)
     {
-        updateKeyModifiers (movedEvent->state);
-        const Point<int> mousePos (movedEvent->x_root, movedEvent->y_root);
+        // Merge any other movements that are already queued for this window, so that a
+        // fast pointer only costs us one mouse callback per batch of events..
+        XPointerMovedEvent movedEvent (*firstEvent);
+        coalescedMousePositions.clearQuick();
 
-        if (lastMousePos != mousePos)
         {
-            lastMousePos = mousePos;
+            ScopedXLock xlock;
+            XEvent nextEvent;
 
-            if (parentWindow != nullptr && (styleFlags & windowHasTitleBar) == 0)
+            while (XEventsQueued (display, QueuedAfterReading) > 0)
             {
-                Window wRoot = 0, wParent = 0;
+                XPeekEvent (display, &nextEvent);
 
-                {
-                    ScopedXLock xlock;
-                    unsigned int numChildren;
-                    Window* wChild = nullptr;
-                    XQueryTree (display, windowH, &wRoot, &wParent, &wChild, &numChildren);
-                }
+                if (nextEvent.type != MotionNotify
+                     || nextEvent.xmotion.window != movedEvent.window
+                     || nextEvent.xmotion.state != movedEvent.state)
+                    break;
 
-                if (wParent != 0
-                     && wParent != windowH
-                     && wParent != wRoot)
-                {
-                    parentWindow = wParent;
-                    updateBounds();
-                }
-                else
-                {
-                    parentWindow = 0;
-                }
+                if (keepCoalescedMouseHistory)
+                    coalescedMousePositions.add (Point<int> (movedEvent.x_root, movedEvent.y_root));
+
+                XNextEvent (display, &nextEvent);
+                movedEvent = nextEvent.xmotion;
             }
+        }
+
+        updateKeyModifiers (movedEvent.state);
+        const Point<int> mousePos (movedEvent.x_root, movedEvent.y_root);
+        pointerPosition = mousePos;
+
+        if (coalescedMousePositions.size() > 0)
+        {
+            coalescedMousePositions.add (mousePos);
+
+            const Point<int> screenPos (getScreenPosition());
 
-            handleMouseEvent (0, mousePos - getScreenPosition(), currentModifiers, getEventTime (movedEvent->time));
+            for (int i = coalescedMousePositions.size(); --i >= 0;)
+                coalescedMousePositions.getReference (i) -= screenPos;
+        }
+
+        if (lastMousePos != mousePos)
+        {
+            lastMousePos = mousePos;
+
+            if (parentWindow != 0 && (styleFlags & windowHasTitleBar) == 0
+                 && movedEvent.window == windowH)
+            {
+                // An embedded window doesn't get told when its parent moves, but the event
+                // contains both the local and screen positions, so no need to ask the server
+                bounds.setPosition (movedEvent.x_root - movedEvent.x,
+                                    movedEvent.y_root - movedEvent.y);
+            }
+
+            // (the peer may have been deleted by this callback, so don't touch any members after it)
+            handleMouseEvent (0, mousePos - getScreenPosition(), currentModifiers, getEventTime (movedEvent.time));
         }
     }
 
     void handleEnterNotifyEvent (const XEnterWindowEvent* const enterEvent)
     {
         clearLastMousePos();
+        pointerPosition = Point<int> (enterEvent->x_root, enterEvent->y_root);
+        windowContainingPointer = windowH;
 
         if (! currentModifiers.isAnyMouseButtonDown())
         {
@@ -1500,6 +1616,9 @@ public:
 
     void handleLeaveNotifyEvent (const XLeaveWindowEvent* const leaveEvent)
     {
+        if (windowContainingPointer == windowH)
+            windowContainingPointer = 0;
+
         // Suppress the normal leave if we've got a pointer grab, or if
         // it's a bogus one caused by clicking a mouse button when running
         // in a Window manager
@@ -1555,9 +1674,20 @@ public:
         }
     }
 
+    void handleGraphicsExposeEvent (const XGraphicsExposeEvent* const exposeEvent)
+    {
+        // part of the source of a scroll was obscured, so the copy of it needs redrawing
+        repaint (Rectangle<int> (exposeEvent->x, exposeEvent->y,
+                                 exposeEvent->width, exposeEvent->height));
+    }
+
     void handleConfigureNotifyEvent (XConfigureEvent* const confEvent)
     {
-        updateBounds();
+        if (confEvent->window == windowH)
+            updateBounds (*confEvent);
+        else
+            updateBounds();
+
         updateBorderSize();
         handleMovedOrResized();
 
@@ -1689,6 +1819,17 @@ public:
     static ModifierKeys currentModifiers;
     static bool isActiveApplication;
 
+    // The last pointer position seen in an event, and the window that it's currently inside.
+    // While the pointer is over one of our windows, every movement and button change is
+    // sent to us, so these are up to date without having to query the server.
+    static Point<int> pointerPosition;
+    static Window windowContainingPointer;
+
+    static bool isPointerTrackedByEvents() noexcept
+    {
+        return windowContainingPointer != 0;
+    }
+
 private:
     //==============================================================================
     class LinuxRepaintManager : public Timer
@@ -1696,7 +1837,8 @@ private:
     public:
         LinuxRepaintManager (LinuxComponentPeer* const peer_)
             : peer (peer_),
-              lastTimeImageUsed (0)
+              lastTimeImageUsed (0),
+              scrollGC (None)
         {
            #if JUCE_USE_XSHM
             shmCompletedDrawing = true;
@@ -1736,16 +1878,89 @@ private:
             }
         }
 
+        ~LinuxRepaintManager()
+        {
+            if (scrollGC != None)
+            {
+                ScopedXLock xlock;
+                XFreeGC (display, scrollGC);
+            }
+        }
+
         void repaint (const Rectangle<int>& area)
         {
             if (! isTimerRunning())
                 startTimer (repaintTimerPeriod);
 
-            regionsNeedingRepaint.add (area);
+            if (areaBeingScrolled.intersects (area))
+            {
+                RectangleList remainder (area);
+                remainder.subtract (areaBeingScrolled);
+                regionsNeedingRepaint.add (remainder);
+            }
+            else
+            {
+                regionsNeedingRepaint.add (area);
+            }
+        }
+
+        void scrollArea (const Rectangle<int>& area, const Point<int>& delta)
+        {
+            const Rectangle<int> destArea (area.getIntersection (area + delta));
+            const Rectangle<int> sourceArea (destArea - delta);
+
+            // Anything in the source that was still waiting to be painted is just as
+            // invalid once it has been moved, and the strip that gets uncovered needs painting
+            RectangleList movedRegions (regionsNeedingRepaint);
+            movedRegions.clipTo (sourceArea);
+            movedRegions.offsetAll (delta.getX(), delta.getY());
+
+            RectangleList exposedArea (area);
+            exposedArea.subtract (destArea);
+
+            regionsNeedingRepaint.subtract (destArea);
+            regionsNeedingRepaint.add (movedRegions);
+            regionsNeedingRepaint.add (exposedArea);
+
+            if (! isTimerRunning())
+                startTimer (repaintTimerPeriod);
+
+            {
+                ScopedXLock xlock;
+
+                if (scrollGC == None)
+                {
+                    // (graphics exposures are needed so that we get told about any parts of
+                    // the source that were covered by other windows and couldn't be copied)
+                    XGCValues gcvalues;
+                    gcvalues.function = GXcopy;
+                    gcvalues.plane_mask = AllPlanes;
+                    gcvalues.graphics_exposures = True;
+
+                    scrollGC = XCreateGC (display, peer->windowH,
+                                          GCFunction | GCPlaneMask | GCGraphicsExposures, &gcvalues);
+                }
+
+                XCopyArea (display, peer->windowH, peer->windowH, scrollGC,
+                           sourceArea.getX(), sourceArea.getY(),
+                           (unsigned int) sourceArea.getWidth(), (unsigned int) sourceArea.getHeight(),
+                           destArea.getX(), destArea.getY());
+            }
+
+            // until scrollFinished() is called, any repaints that the move triggers inside the
+            // copied area are ignored, as the pixels there are already correct
+            areaBeingScrolled = destArea;
+        }
+
+        void scrollFinished()
+        {
+            areaBeingScrolled = Rectangle<int>();
         }
 
         void performAnyPendingRepaintsNow()
         {
+            Component::dispatchPendingRepaints();
+
            #if JUCE_USE_XSHM
             if (! shmCompletedDrawing)
             {
@@ -1827,6 +2042,8 @@ private:
         Image image;
         uint32 lastTimeImageUsed;
         RectangleList regionsNeedingRepaint;
+        Rectangle<int> areaBeingScrolled;
+        GC scrollGC;
 
        #if JUCE_USE_XSHM
         bool useARGBImagesForRendering, shmCompletedDrawing;
@@ -1840,7 +2057,7 @@ private:
     Window windowH, parentWindow;
     Rectangle<int> bounds;
     Image taskbarImage;
-    bool fullScreen, mapped;
+    bool fullScreen, mapped, focusPendingUntilMapped;
     Visual* visual;
     int depth;
     BorderSize<int> windowBorder;
@@ -2113,6 +2330,7 @@ private:
         swa.override_redirect = (getComponent()->isAlwaysOnTop() && (styleFlags & windowIsTemporary) != 0) ? True : False;
         swa.event_mask = getAllEventsMask();
 
+        parentWindow = parentToAddTo;
         windowH = XCreateWindow (display, parentToAddTo != 0 ? parentToAddTo : root,
                                  0, 0, 1, 1,
                                  0, depth, InputOutput, visual,
@@ -2251,15 +2469,45 @@ private:
             unsigned int ww = 0, wh = 0, bw, depth;
 
             ScopedXLock xlock;
+            RoundTripCounter::add();
 
             if (XGetGeometry (display, (::Drawable) windowH, &root, &wx, &wy, &ww, &wh, &bw, &depth))
+            {
+                RoundTripCounter::add();
+
                 if (! XTranslateCoordinates (display, windowH, root, 0, 0, &wx, &wy, &child))
                     wx = wy = 0;
+            }
 
             bounds.setBounds (wx, wy, ww, wh);
         }
     }
 
+    void updateBounds (const XConfigureEvent& confEvent)
+    {
+        // The size is always in the event. The position is relative to the parent, so it's
+        // only a screen position if the parent is the root window, or if the event was sent
+        // by the window manager, which always uses screen coordinates.
+        if (confEvent.send_event || parentWindow == 0)
+        {
+            bounds.setBounds (confEvent.x, confEvent.y, confEvent.width, confEvent.height);
+        }
+        else
+        {
+            Window child;
+            int wx = 0, wy = 0;
+
+            ScopedXLock xlock;
+            RoundTripCounter::add();
+
+            if (! XTranslateCoordinates (display, windowH, RootWindow (display, DefaultScreen (display)),
+                                         0, 0, &wx, &wy, &child))
+                wx = wy = 0;
+
+            bounds.setBounds (wx, wy, confEvent.width, confEvent.height);
+        }
+    }
+
     //==============================================================================
     void resetDragAndDrop()
     {
@@ -2549,6 +2797,8 @@ private:
 ModifierKeys LinuxComponentPeer::currentModifiers;
 bool LinuxComponentPeer::isActiveApplication = false;
 Point<int> LinuxComponentPeer::lastMousePos;
+Point<int> LinuxComponentPeer::pointerPosition;
+Window LinuxComponentPeer::windowContainingPointer = 0;
 
 //==============================================================================
 bool Process::isForegroundProcess()
@@ -2564,12 +2814,18 @@ void ModifierKeys::updateCurrentModifiers() noexcept
 
 ModifierKeys ModifierKeys::getCurrentModifiersRealtime() noexcept
 {
+    // (the keyboard modifiers only arrive in our events while we've got the focus - if another
+    // app has it, they could have changed without us hearing about it)
+    if (LinuxComponentPeer::isPointerTrackedByEvents() && LinuxComponentPeer::isActiveApplication)
+        return LinuxComponentPeer::currentModifiers;
+
     Window root, child;
     int x, y, winx, winy;
     unsigned int mask;
     int mouseMods = 0;
 
     ScopedXLock xlock;
+    RoundTripCounter::add();
 
     if (XQueryPointer (display, RootWindow (display, DefaultScreen (display)),
                        &root, &child, &x, &y, &winx, &winy, &mask) != False)
@@ -2761,11 +3017,15 @@ bool Desktop::canUseSemiTransparentWindows() noexcept
 
 Point<int> MouseInputSource::getCurrentMousePosition()
 {
+    if (LinuxComponentPeer::isPointerTrackedByEvents())
+        return LinuxComponentPeer::pointerPosition;
+
     Window root, child;
     int x, y, winx, winy;
     unsigned int mask;
 
     ScopedXLock xlock;
+    RoundTripCounter::add();
 
     if (XQueryPointer (display,
                        RootWindow (display, DefaultScreen (display)),
@@ -3145,3 +3405,106 @@ const int KeyPress::playKey                 = (0xffeeff00) | Keys::extendedKeyMo
 const int KeyPress::stopKey                 = (0xffeeff01) | Keys::extendedKeyModifier;
 const int KeyPress::fastForwardKey          = (0xffeeff02) | Keys::extendedKeyModifier;
 const int KeyPress::rewindKey               = (0xffeeff03) | Keys::extendedKeyModifier;
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS && JUCE_DEBUG
+
+// These need a real X server, so on a headless machine, run them under Xvfb.
+class LinuxRoundTripTests  : public UnitTest
+{
+public:
+    LinuxRoundTripTests() : UnitTest ("X11 round trips") {}
+
+    class TestWindow  : public Component
+    {
+    public:
+        TestWindow()                    { setOpaque (true); }
+        void paint (Graphics& g)        { g.fillAll (Colours::white); }
+    };
+
+    static void dispatchFor (const int milliseconds)
+    {
+        MessageManager::getInstance()->runDispatchLoopUntil (milliseconds);
+    }
+
+    void runTest()
+    {
+        beginTest ("Pointer tracking");
+
+        if (display == nullptr || ! MessageManager::getInstance()->isThisTheMessageThread())
+        {
+            logMessage ("No X display available - skipping");
+            return;
+        }
+
+        TestWindow window;
+        window.setWantsKeyboardFocus (true);
+        window.addToDesktop (ComponentPeer::windowIsTemporary);
+        window.setBounds (100, 100, 200, 150);
+        window.setVisible (true);
+        window.toFront (true);
+        dispatchFor (200);
+
+        {
+            ScopedXLock xlock;
+            XWarpPointer (display, None, RootWindow (display, DefaultScreen (display)), 0, 0, 0, 0, 150, 160);
+            XFlush (display);
+        }
+
+        dispatchFor (200);
+
+        int numBefore = RoundTripCounter::getTotal();
+        const Point<int> mousePos (Desktop::getMousePosition());
+        ModifierKeys::getCurrentModifiersRealtime();
+
+        expectEquals (RoundTripCounter::getTotal() - numBefore, 0);
+        expect (mousePos == Point<int> (150, 160));
+
+        beginTest ("Modifiers while another app has the focus");
+
+        {
+            ScopedXLock xlock;
+            XSetInputFocus (display, RootWindow (display, DefaultScreen (display)), RevertToParent, CurrentTime);
+        }
+
+        dispatchFor (200);
+
+        numBefore = RoundTripCounter::getTotal();
+        ModifierKeys::getCurrentModifiersRealtime();
+        expectEquals (RoundTripCounter::getTotal() - numBefore, 1);
+
+        beginTest ("Moving a window");
+
+        numBefore = RoundTripCounter::getTotal();
+
+        for (int i = 1; i <= 20; ++i)
+        {
+            window.setTopLeftPosition (100 + i * 5, 100);
+            dispatchFor (20);
+        }
+
+        const int numForMoves = RoundTripCounter::getTotal() - numBefore;
+        logMessage ("Round trips for 20 moves: " + String (numForMoves)
+                      + ", in the last second: " + String (RoundTripCounter::getNumInLastSecond()));
+
+        expect (numForMoves <= 20);
+        expect (window.getScreenPosition() == Point<int> (200, 100));
+
+        beginTest ("Focus requested before the window is mapped");
+
+        TestWindow focusWindow;
+        focusWindow.setBounds (400, 100, 100, 100);
+        focusWindow.setWantsKeyboardFocus (true);
+        focusWindow.addToDesktop (0);
+        focusWindow.setVisible (true);
+        focusWindow.toFront (true);
+        dispatchFor (200);
+
+        expect (focusWindow.getPeer() != nullptr && focusWindow.getPeer()->isFocused());
+    }
+};
+
+static LinuxRoundTripTests linuxRoundTripTests;
+
+#endif
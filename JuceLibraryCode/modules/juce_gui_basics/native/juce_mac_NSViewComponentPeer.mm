@@ -1862,6 +1862,7 @@ void NSViewComponentPeer::repaint (const Rectangle<int>& area)
 
 void NSViewComponentPeer::performAnyPendingRepaintsNow()
 {
+    Component::dispatchPendingRepaints();
     [view displayIfNeeded];
 }
 
@@ -843,6 +843,8 @@ public:
 
     void performAnyPendingRepaintsNow()
     {
+        Component::dispatchPendingRepaints();
+
         MSG m;
         if (component->isVisible()
              && (PeekMessage (&m, hwnd, WM_PAINT, WM_PAINT, PM_REMOVE) || isUsingUpdateLayeredWindow()))
@@ -32,10 +32,13 @@ Label::Label (const String& name,
       justification (Justification::centredLeft),
       horizontalBorderSize (5),
       verticalBorderSize (1),
+      fittedTextWidth (0),
+      fittedTextHeight (0),
       minimumHorizontalScale (0.7f),
       editSingleClick (false),
       editDoubleClick (false),
-      lossOfFocusDiscardsChanges (false)
+      lossOfFocusDiscardsChanges (false),
+      fittedTextNeedsUpdate (true)
 {
     setColour (TextEditor::textColourId, Colours::black);
     setColour (TextEditor::backgroundColourId, Colours::transparentBlack);
@@ -64,6 +67,7 @@ void Label::setText (const String& newText,
     {
         lastTextValue = newText;
         textValue = newText;
+        fittedTextNeedsUpdate = true;
         repaint();
 
         textWasChanged();
@@ -95,6 +99,7 @@ void Label::setFont (const Font& newFont)
     if (font != newFont)
     {
         font = newFont;
+        fittedTextNeedsUpdate = true;
         repaint();
     }
 }
@@ -121,6 +126,7 @@ void Label::setJustificationType (const Justification& newJustification)
     if (justification != newJustification)
     {
         justification = newJustification;
+        fittedTextNeedsUpdate = true;
         repaint();
     }
 }
@@ -131,10 +137,37 @@ void Label::setBorderSize (int h, int v)
     {
         horizontalBorderSize = h;
         verticalBorderSize = v;
+        fittedTextNeedsUpdate = true;
         repaint();
     }
 }
 
+const GlyphArrangement& Label::getFittedText()
+{
+    // (the size is checked here rather than relying on resized(), which a subclass might
+    // override without calling this class's version)
+    if (fittedTextNeedsUpdate || fittedTextWidth != getWidth() || fittedTextHeight != getHeight())
+    {
+        fittedTextNeedsUpdate = false;
+        fittedTextWidth = getWidth();
+        fittedTextHeight = getHeight();
+        fittedText.clear();
+
+        const int w = getWidth() - 2 * horizontalBorderSize;
+        const int h = getHeight() - 2 * verticalBorderSize;
+        const String text (getText());
+
+        if (text.isNotEmpty() && w > 0 && h > 0)
+            fittedText.addFittedText (font, text,
+                                      (float) horizontalBorderSize, (float) verticalBorderSize,
+                                      (float) w, (float) h, justification,
+                                      jmax (1, (int) (getHeight() / font.getHeight())),
+                                      minimumHorizontalScale);
+    }
+
+    return fittedText;
+}
+
 //==============================================================================
 Component* Label::getAttachedComponent() const
 {
@@ -222,6 +255,7 @@ bool Label::updateFromTextEditorContents (TextEditor& ed)
     {
         lastTextValue = newText;
         textValue = newText;
+        fittedTextNeedsUpdate = true;
         repaint();
 
         textWasChanged();
@@ -348,6 +382,7 @@ void Label::setMinimumHorizontalScale (const float newScale)
     if (minimumHorizontalScale != newScale)
     {
         minimumHorizontalScale = newScale;
+        fittedTextNeedsUpdate = true;
         repaint();
     }
 }
@@ -169,6 +169,15 @@ public:
 
     float getMinimumHorizontalScale() const noexcept                            { return minimumHorizontalScale; }
 
+    /** Returns the label's text, laid out to fit inside the area within its borders.
+
+        This uses the same rules as Graphics::drawFittedText(), but the arrangement is
+        cached, and only gets rebuilt after the text, font, size, border, justification
+        or minimum horizontal scale have been changed. The default LookAndFeel::drawLabel()
+        draws from this, so repainting a label doesn't need to re-fit its text each time.
+    */
+    const GlyphArrangement& getFittedText();
+
     //==============================================================================
     /**
         A class for receiving events from a Label.
@@ -325,12 +334,15 @@ private:
     ScopedPointer<TextEditor> editor;
     ListenerList<Listener> listeners;
     WeakReference<Component> ownerComponent;
+    GlyphArrangement fittedText;
     int horizontalBorderSize, verticalBorderSize;
+    int fittedTextWidth, fittedTextHeight;
     float minimumHorizontalScale;
     bool editSingleClick : 1;
     bool editDoubleClick : 1;
     bool lossOfFocusDiscardsChanges : 1;
     bool leftOfOwnerComp : 1;
+    bool fittedTextNeedsUpdate : 1;
 
     bool updateFromTextEditorContents (TextEditor&);
     void callChangeListeners();
@@ -295,6 +295,22 @@ public:
         }
     }
 
+    void refreshRows (const SparseSet<int>& rowsToRefresh)
+    {
+        for (int i = 0; i < rows.size(); ++i)
+        {
+            const int row = firstIndex + i;
+
+            if (row < owner.totalItems && rowsToRefresh.contains (row))
+            {
+                ListBoxRowComponent* const rowComp = getComponentForRow (row);
+
+                rowComp->update (row, owner.isRowSelected (row));
+                rowComp->repaint();
+            }
+        }
+    }
+
     void paint (Graphics& g)
     {
         if (isOpaque())
@@ -327,6 +343,46 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ListViewport);
 };
 
+//==============================================================================
+class ListBox::RowUpdater  : public AsyncUpdater
+{
+public:
+    RowUpdater (ListBox& owner_)
+        : owner (owner_)
+    {
+    }
+
+    void addRow (const int row)
+    {
+        {
+            const ScopedLock sl (lock);
+            rowsToRefresh.addRange (Range<int> (row, row + 1));
+        }
+
+        triggerAsyncUpdate();
+    }
+
+    void handleAsyncUpdate()
+    {
+        SparseSet<int> rows;
+
+        {
+            const ScopedLock sl (lock);
+            rows = rowsToRefresh;
+            rowsToRefresh.clear();
+        }
+
+        owner.viewport->refreshRows (rows);
+    }
+
+private:
+    ListBox& owner;
+    SparseSet<int> rowsToRefresh;
+    CriticalSection lock;
+
+    JUCE_DECLARE_NON_COPYABLE (RowUpdater);
+};
+
 enum { defaultListRowHeight = 22 };
 
 //==============================================================================
@@ -343,6 +399,7 @@ ListBox::ListBox (const String& name, ListBoxModel* const model_)
       hasDoneInitialUpdate (false)
 {
     addAndMakeVisible (viewport = new ListViewport (*this));
+    rowUpdater = new RowUpdater (*this);
 
     ListBox::setWantsKeyboardFocus (true);
     ListBox::colourChanged();
@@ -350,6 +407,7 @@ ListBox::ListBox (const String& name, ListBoxModel* const model_)
 
 ListBox::~ListBox()
 {
+    rowUpdater = nullptr;
     headerComponent = nullptr;
     viewport = nullptr;
 }
@@ -858,6 +916,12 @@ void ListBox::repaintRow (const int rowNumber) noexcept
     repaint (getRowPosition (rowNumber, true));
 }
 
+void ListBox::rowDataChanged (const int rowNumber)
+{
+    if (rowNumber >= 0)
+        rowUpdater->addRow (rowNumber);
+}
+
 Image ListBox::createSnapshotOfSelectedRows (int& imageX, int& imageY)
 {
     Rectangle<int> imageArea;
@@ -50,6 +50,11 @@ public:
     virtual int getNumRows() = 0;
 
     /** This method must be implemented to draw a row of the list.
+
+        If the data for the row isn't available yet (e.g. it has to be read from disk),
+        this should draw a placeholder rather than waiting for it, and start fetching the
+        data in the background. When it has arrived, call ListBox::rowDataChanged() to get
+        the row refreshed.
     */
     virtual void paintListBoxItem (int rowNumber,
                                    Graphics& g,
@@ -497,6 +502,22 @@ public:
     */
     void repaintRow (int rowNumber) noexcept;
 
+    /** Tells the list that the data for a row has changed, and that it needs refreshing.
+
+        Unlike updateContent() and repaintRow(), this can be called from any thread, so it's
+        useful for models that load their data lazily: the model can paint a placeholder for
+        a row whose data isn't ready, fetch it on a background thread, and call this method
+        when it arrives.
+
+        The rows are refreshed asynchronously on the message thread, so many calls made in
+        quick succession get handled together, and rows that have been scrolled off-screen in
+        the meantime are just skipped. Any custom component for a refreshed row will be
+        updated by calling ListBoxModel::refreshComponentForRow(), and the row will be repainted.
+
+        @see updateContent, repaintRow
+    */
+    void rowDataChanged (int rowNumber);
+
     /** This fairly obscure method creates an image that just shows the currently
         selected row components.
 
@@ -555,10 +576,13 @@ public:
 private:
     //==============================================================================
     class ListViewport;
+    class RowUpdater;
     friend class ListViewport;
+    friend class RowUpdater;
     friend class TableListBox;
     ListBoxModel* model;
     ScopedPointer<ListViewport> viewport;
+    ScopedPointer<RowUpdater> rowUpdater;
     ScopedPointer<Component> headerComponent;
     int totalItems, rowHeight, minimumRowWidth;
     int outlineThickness;
@@ -78,16 +78,29 @@ public:
             const Identifier columnProperty ("_tableColumnId");
             const int numColumns = owner.getHeader().getNumColumns (true);
 
+            // Any cells that are now in the wrong column are handed back to the table first, so
+            // that when columns are moved around, the components can follow them..
+            while (columnComponents.size() > numColumns)
+                owner.addSpareCellComponent (columnComponents.removeAndReturn (numColumns));
+
+            for (int i = columnComponents.size(); --i >= 0;)
+            {
+                Component* const comp = columnComponents.getUnchecked (i);
+
+                if (comp != nullptr && owner.getHeader().getColumnIdOfIndex (i, true) != (int) comp->getProperties() [columnProperty])
+                {
+                    columnComponents.set (i, nullptr, false);
+                    owner.addSpareCellComponent (comp);
+                }
+            }
+
             for (int i = 0; i < numColumns; ++i)
             {
                 const int columnId = owner.getHeader().getColumnIdOfIndex (i, true);
                 Component* comp = columnComponents[i];
 
-                if (comp != nullptr && columnId != (int) comp->getProperties() [columnProperty])
-                {
-                    columnComponents.set (i, nullptr);
-                    comp = nullptr;
-                }
+                if (comp == nullptr)
+                    comp = owner.takeSpareCellComponent (columnId);
 
                 comp = model->refreshComponentForCell (row, columnId, isSelected, comp);
                 columnComponents.set (i, comp, false);
@@ -100,12 +113,11 @@ public:
                     resizeCustomComp (i);
                 }
             }
-
-            columnComponents.removeRange (numColumns, columnComponents.size());
         }
         else
         {
-            columnComponents.clear();
+            while (columnComponents.size() > 0)
+                owner.addSpareCellComponent (columnComponents.removeAndReturn (0));
         }
     }
 
@@ -251,6 +263,125 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TableListBoxHeader);
 };
 
+//==============================================================================
+class TableListBox::ColumnAutoSizer  : private Timer
+{
+public:
+    ColumnAutoSizer (TableListBox& owner_, const int columnId_)
+        : owner (owner_), columnId (columnId_), nextRowToMeasure (0),
+          widestText (0), currentWidth (0)
+    {
+    }
+
+    int getColumnId() const noexcept        { return columnId; }
+    bool isFinished() const noexcept        { return ! isTimerRunning(); }
+
+    void start()
+    {
+        TableListBoxModel* const model = owner.getModel();
+        const int numRows = owner.getNumRows();
+
+        if (model == nullptr || numRows <= 0)
+            return;
+
+        font = model->getCellFont (columnId);
+
+        if (numRows <= maxRowsToMeasureImmediately)
+        {
+            measureRows (0, numRows, 1);
+            applyWidth();
+            return;
+        }
+
+        const int firstVisibleRow = jmax (0, owner.getRowContainingPosition (0, 0));
+        measureRows (firstVisibleRow, jmin (numRows, firstVisibleRow + owner.getNumRowsOnScreen() + 1), 1);
+        measureRows (0, numRows, numRows / numRowsToSample);
+
+        // if none of the sample had any text, the model probably doesn't provide it..
+        if (widestText > 0)
+        {
+            applyWidth();
+            startTimer (1);
+        }
+    }
+
+private:
+    TableListBox& owner;
+    const int columnId;
+    int nextRowToMeasure;
+    float widestText;
+    int currentWidth;
+    Font font;
+    StringArray texts;
+    Array<float> widths;
+
+    enum
+    {
+        maxRowsToMeasureImmediately = 2000,
+        numRowsToSample = 1000,
+        rowsPerBatch = 500,
+        maxMillisecondsPerCallback = 20,
+        margin = 8
+    };
+
+    void measureRows (const int startRow, const int endRow, const int step)
+    {
+        TableListBoxModel* const model = owner.getModel();
+        texts.clear();
+
+        for (int row = startRow; row < endRow; row += step)
+            texts.add (model->getCellText (row, columnId));
+
+        font.getStringWidths (texts, widths);
+
+        for (int i = widths.size(); --i >= 0;)
+            widestText = jmax (widestText, widths.getUnchecked (i));
+    }
+
+    void applyWidth()
+    {
+        if (widestText > 0)
+        {
+            const int newWidth = roundToInt (widestText) + margin;
+
+            if (newWidth > currentWidth || ! isTimerRunning())
+            {
+                owner.getHeader().setColumnWidth (columnId, newWidth);
+                currentWidth = owner.getHeader().getColumnWidth (columnId);
+            }
+        }
+    }
+
+    void timerCallback()
+    {
+        const int numRows = owner.getNumRows();
+
+        // stop if the model has gone, or the user has dragged the column to a different size..
+        if (owner.getModel() == nullptr || owner.getHeader().getColumnWidth (columnId) != currentWidth)
+        {
+            stopTimer();
+            return;
+        }
+
+        const uint32 startTime = Time::getMillisecondCounter();
+
+        while (nextRowToMeasure < numRows
+                && Time::getMillisecondCounter() < startTime + maxMillisecondsPerCallback)
+        {
+            const int endRow = jmin (numRows, nextRowToMeasure + (int) rowsPerBatch);
+            measureRows (nextRowToMeasure, endRow, 1);
+            nextRowToMeasure = endRow;
+        }
+
+        applyWidth();
+
+        if (nextRowToMeasure >= numRows)
+            stopTimer();
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (ColumnAutoSizer);
+};
+
 //==============================================================================
 TableListBox::TableListBox (const String& name, TableListBoxModel* const model_)
     : ListBox (name, nullptr),
@@ -272,6 +403,8 @@ void TableListBox::setModel (TableListBoxModel* const newModel)
     if (model != newModel)
     {
         model = newModel;
+        spareCellComponents.clear();
+        columnAutoSizers.clear();
         updateContent();
     }
 }
@@ -305,10 +438,26 @@ void TableListBox::setHeaderHeight (const int newHeight)
 
 void TableListBox::autoSizeColumn (const int columnId)
 {
-    const int width = model != nullptr ? model->getColumnAutoSizeWidth (columnId) : 0;
+    for (int i = columnAutoSizers.size(); --i >= 0;)
+        if (columnAutoSizers.getUnchecked(i)->getColumnId() == columnId
+             || columnAutoSizers.getUnchecked(i)->isFinished())
+            columnAutoSizers.remove (i);
+
+    if (model != nullptr)
+    {
+        const int width = model->getColumnAutoSizeWidth (columnId);
 
-    if (width > 0)
-        header->setColumnWidth (columnId, width);
+        if (width > 0)
+        {
+            header->setColumnWidth (columnId, width);
+        }
+        else
+        {
+            ColumnAutoSizer* const sizer = new ColumnAutoSizer (*this, columnId);
+            columnAutoSizers.add (sizer);
+            sizer->start();
+        }
+    }
 }
 
 void TableListBox::autoSizeAllColumns()
@@ -463,12 +612,42 @@ void TableListBox::updateColumnComponents() const
     }
 }
 
+void TableListBox::addSpareCellComponent (Component* const comp)
+{
+    if (comp != nullptr)
+    {
+        Component* const parent = comp->getParentComponent();
+
+        if (parent != nullptr)
+            parent->removeChildComponent (comp);
+
+        // only keep enough spares to fill a screenful of rows..
+        if (spareCellComponents.size() < header->getNumColumns (true) * (getNumRowsOnScreen() + 2))
+            spareCellComponents.add (comp);
+        else
+            delete comp;
+    }
+}
+
+Component* TableListBox::takeSpareCellComponent (const int columnId)
+{
+    const Identifier columnProperty ("_tableColumnId");
+
+    for (int i = spareCellComponents.size(); --i >= 0;)
+        if (columnId == (int) spareCellComponents.getUnchecked(i)->getProperties() [columnProperty])
+            return spareCellComponents.removeAndReturn (i);
+
+    return nullptr;
+}
+
 //==============================================================================
 void TableListBoxModel::cellClicked (int, int, const MouseEvent&)       {}
 void TableListBoxModel::cellDoubleClicked (int, int, const MouseEvent&) {}
 void TableListBoxModel::backgroundClicked()                             {}
 void TableListBoxModel::sortOrderChanged (int, const bool)              {}
 int TableListBoxModel::getColumnAutoSizeWidth (int)                     { return 0; }
+String TableListBoxModel::getCellText (int, int)                        { return String::empty; }
+Font TableListBoxModel::getCellFont (int)                               { return Font(); }
 void TableListBoxModel::selectedRowsChanged (int)                       {}
 void TableListBoxModel::deleteKeyPressed (int)                          {}
 void TableListBoxModel::returnKeyPressed (int)                          {}
@@ -70,6 +70,11 @@ public:
 
         The graphics context's origin will already be set to the top-left of the cell,
         whose size is specified by (width, height).
+
+        This is called on the message thread while the table is being painted, so if the data
+        for the row has to be fetched from somewhere slow, don't block here - draw a placeholder
+        instead, fetch the data in the background, and call ListBox::rowDataChanged() when it
+        arrives.
     */
     virtual void paintCell (Graphics& g,
                             int rowNumber,
@@ -95,6 +100,10 @@ public:
         by this method. In this case, the method must either update it to make sure it's correctly representing
         the given cell (which may be different from the one that the component was created for), or it can
         delete this component and return a new one.
+
+        The table recycles cell components: one that was created for a cell in a particular column
+        may later be passed back in for a cell in the same column but a different row, e.g. after the
+        columns have been rearranged or the number of rows has changed.
     */
     virtual Component* refreshComponentForCell (int rowNumber, int columnId, bool isRowSelected,
                                                 Component* existingComponentToUpdate);
@@ -138,12 +147,35 @@ public:
         If you implement this method, you should measure the width of all the items
         in this column, and return the best size.
 
-        Returning 0 means that the column shouldn't be changed.
+        Returning 0 means that the column shouldn't be changed, unless getCellText() has
+        been implemented, in which case the table will measure the column's text itself.
 
         This is used by TableListBox::autoSizeColumn() and TableListBox::autoSizeAllColumns().
+        @see getCellText
     */
     virtual int getColumnAutoSizeWidth (int columnId);
 
+    /** Returns the text shown in a cell, so that the table can measure it when auto-sizing.
+
+        If getColumnAutoSizeWidth() returns 0 for a column, TableListBox::autoSizeColumn() will
+        call this for the column's rows, measure the strings with the font returned by
+        getCellFont(), and fit the column to the widest one (plus a few pixels of margin).
+
+        To keep things responsive with very large tables, only the rows on screen and an even
+        sample of the others are measured straight away; the remaining rows are then measured
+        a batch at a time in the background, and the column is widened if any of them need
+        more room. This stops if the user changes the column's width in the meantime.
+
+        The default implementation returns an empty string, and if none of the sampled rows
+        have any text, the column is left alone.
+    */
+    virtual String getCellText (int rowNumber, int columnId);
+
+    /** Returns the font that a column's text is drawn with.
+        This is used with getCellText() when auto-sizing a column.
+    */
+    virtual Font getCellFont (int columnId);
+
     /** Returns a tooltip for a particular cell in the table.
     */
     virtual String getCellTooltip (int rowNumber, int columnId);
@@ -246,7 +278,9 @@ public:
     /** Resizes a column to fit its contents.
 
         This uses TableListBoxModel::getColumnAutoSizeWidth() to find the best width,
-        and applies that to the column.
+        and applies that to the column. If that returns 0, the column will be fitted to the
+        text returned by TableListBoxModel::getCellText(), which may carry on widening the
+        column in the background for a while if the table is very large.
 
         @see autoSizeAllColumns, TableHeaderComponent::setColumnWidth
     */
@@ -326,8 +360,16 @@ private:
     TableListBoxModel* model;
     int columnIdNowBeingDragged;
     bool autoSizeOptionsShown;
+    OwnedArray<Component> spareCellComponents;
+
+    class ColumnAutoSizer;
+    friend class ColumnAutoSizer;
+    OwnedArray<ColumnAutoSizer> columnAutoSizers;
 
+    friend class TableListRowComp;
     void updateColumnComponents() const;
+    void addSpareCellComponent (Component*);
+    Component* takeSpareCellComponent (int columnId);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TableListBox);
 };
@@ -35,6 +35,7 @@ ComponentPeer::ComponentPeer (Component* const component_, const int styleFlags_
       styleFlags (styleFlags_),
       lastPaintTime (0),
       constrainer (nullptr),
+      keepCoalescedMouseHistory (false),
       lastDragAndDropCompUnderMouse (nullptr),
       uniqueID (lastUniqueID += 2), // increment by 2 so that this can never hit 0
       fakeMouseMessageSent (false),
@@ -84,6 +85,14 @@ void ComponentPeer::updateCurrentModifiers() noexcept
 }
 
 //==============================================================================
+void ComponentPeer::setCoalescedMouseHistoryEnabled (const bool shouldBeEnabled) noexcept
+{
+    keepCoalescedMouseHistory = shouldBeEnabled;
+
+    if (! shouldBeEnabled)
+        coalescedMousePositions.clear();
+}
+
 void ComponentPeer::handleMouseEvent (const int touchIndex, const Point<int>& positionWithinPeer, const ModifierKeys& newMods, const int64 time)
 {
     MouseInputSource* const mouse = Desktop::getInstance().getMouseSource (touchIndex);
@@ -103,6 +112,8 @@ void ComponentPeer::handleMouseWheel (const int touchIndex, const Point<int>& po
 //==============================================================================
 void ComponentPeer::handlePaint (LowLevelGraphicsContext& contextToPaintTo)
 {
+    Component::dispatchPendingRepaints();
+
     Graphics g (&contextToPaintTo);
 
    #if JUCE_ENABLE_REPAINT_DEBUGGING
@@ -284,6 +295,11 @@ void ComponentPeer::dismissPendingTextInput()
 {
 }
 
+bool ComponentPeer::scrollArea (const Rectangle<int>&, const Point<int>&, Component&, const Point<int>&)
+{
+    return false;
+}
+
 //==============================================================================
 void ComponentPeer::handleBroughtToFront()
 {
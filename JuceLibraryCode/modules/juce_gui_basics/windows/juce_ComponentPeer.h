@@ -302,9 +302,47 @@ public:
     */
     virtual void performAnyPendingRepaintsNow() = 0;
 
+    /** Tries to move a child component by shifting the pixels that are already on-screen,
+        rather than repainting the whole area that it covers.
+
+        The peer should copy the area of the window given by areaToScroll (which is
+        relative to the peer's top-left) by the given delta, move the component to its new
+        position without invalidating the copied pixels, and then only repaint the strip
+        that has been uncovered.
+
+        It's up to the caller to make sure that a straight copy will produce the correct
+        result - i.e. that the component is opaque and that nothing else overlaps it.
+
+        If the peer can't do this, it'll return false without doing anything, and the
+        caller will need to move the component normally.
+    */
+    virtual bool scrollArea (const Rectangle<int>& areaToScroll, const Point<int>& delta,
+                             Component& componentToMove, const Point<int>& newComponentPosition);
+
     /** Changes the window's transparency. */
     virtual void setAlpha (float newAlpha) = 0;
 
+    //==============================================================================
+    /** Enables recording of the mouse positions that get merged into a single move or drag.
+
+        When the mouse moves faster than events can be handled, a peer may combine a run of
+        queued mouse movements into a single mouseMove or mouseDrag callback for the most
+        recent position. Apps that need every sample (e.g. for drawing a smooth stroke) can
+        turn this on, and then call getCoalescedMousePositions() from inside their callback.
+
+        By default this is disabled.
+    */
+    void setCoalescedMouseHistoryEnabled (bool shouldBeEnabled) noexcept;
+
+    /** Returns the positions that were merged to create the mouse event being handled.
+
+        The positions are relative to the peer's top-left, in the order in which they
+        arrived, with the last one being the position of the event itself. The array is
+        only filled-in if setCoalescedMouseHistoryEnabled() has been turned on, and will be
+        empty if no events were merged, or on platforms that don't merge mouse events.
+    */
+    const Array<Point<int> >& getCoalescedMousePositions() const noexcept   { return coalescedMousePositions; }
+
     //==============================================================================
     void handleMouseEvent (int touchIndex, const Point<int>& positionWithinPeer, const ModifierKeys& newMods, int64 time);
     void handleMouseWheel (int touchIndex, const Point<int>& positionWithinPeer, int64 time, float x, float y);
@@ -369,6 +407,8 @@ protected:
     Rectangle<int> lastNonFullscreenBounds;
     uint32 lastPaintTime;
     ComponentBoundsConstrainer* constrainer;
+    Array<Point<int> > coalescedMousePositions;
+    bool keepCoalescedMouseHistory;
 
     static void updateCurrentModifiers() noexcept;
 